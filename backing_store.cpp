@@ -0,0 +1,67 @@
+#include "backing_store.h"
+#include <iostream>
+
+bool BackingStore::open(const std::string& storePath, int slotSize) {
+    std::lock_guard<std::mutex> guard(lock);
+    path = storePath;
+    pageSize = slotSize;
+    slotCount = 0;
+    freeSlots.clear();
+
+    if (file.is_open()) file.close();
+    file.open(path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open backing store.\n";
+        return false;
+    }
+    return true;
+}
+
+int BackingStore::allocateSlot() {
+    std::lock_guard<std::mutex> guard(lock);
+    if (!freeSlots.empty()) {
+        int slot = freeSlots.back();
+        freeSlots.pop_back();
+        return slot;
+    }
+    return slotCount++;
+}
+
+void BackingStore::freeSlot(int slot) {
+    if (slot < 0) return;
+    std::lock_guard<std::mutex> guard(lock);
+    freeSlots.push_back(slot);
+}
+
+bool BackingStore::writeSlot(int slot, const uint8_t* data) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (!file.is_open()) {
+        std::cerr << "[ERROR] Backing store file not open for writing.\n";
+        return false;
+    }
+    file.seekp(static_cast<std::streamoff>(slot) * pageSize);
+    file.write(reinterpret_cast<const char*>(data), pageSize);
+    return static_cast<bool>(file);
+}
+
+bool BackingStore::readSlot(int slot, uint8_t* data) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (!file.is_open()) return false;
+    file.seekg(static_cast<std::streamoff>(slot) * pageSize);
+    file.read(reinterpret_cast<char*>(data), pageSize);
+    if (!file) {
+        file.clear();
+        return false;
+    }
+    return true;
+}
+
+int BackingStore::getSlotCount() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return slotCount;
+}
+
+int BackingStore::getUsedSlots() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return slotCount - static_cast<int>(freeSlots.size());
+}
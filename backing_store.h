@@ -0,0 +1,36 @@
+#ifndef BACKING_STORE_H
+#define BACKING_STORE_H
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Header file for backing_store.cpp
+// Binary swap file made of fixed-size page slots: slot i lives at byte
+// offset i * pageSize, so the file can be read back (or mmap'd) directly.
+// Freed slots are reused before the file is grown. Safe to call from any core.
+class BackingStore {
+public:
+    bool open(const std::string& path, int pageSize);  // Truncates any previous contents
+
+    int allocateSlot();
+    void freeSlot(int slot);
+
+    bool writeSlot(int slot, const uint8_t* data);
+    bool readSlot(int slot, uint8_t* data);
+
+    int getSlotCount() const;           // Slots ever used (file size / pageSize)
+    int getUsedSlots() const;
+
+private:
+    mutable std::mutex lock;            // One seek position, so one slot transfer at a time
+    std::fstream file;
+    std::string path;
+    int pageSize = 0;
+    int slotCount = 0;
+    std::vector<int> freeSlots;
+};
+
+#endif
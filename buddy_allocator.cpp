@@ -0,0 +1,85 @@
+#include "buddy_allocator.h"
+#include <algorithm>
+
+BuddyAllocator::BuddyAllocator(int minBlockBytes, int maxBlockBytes) {
+    minOrder = 0;
+    while ((1 << minOrder) < minBlockBytes) minOrder++;
+    maxOrder = minOrder;
+    while ((1 << maxOrder) < maxBlockBytes) maxOrder++;
+    freeLists.resize(maxOrder - minOrder + 1);
+}
+
+int BuddyAllocator::orderOf(int bytes) const {
+    if (bytes <= 0 || (bytes & (bytes - 1)) != 0) return -1;
+    int order = 0;
+    while ((1 << order) < bytes) order++;
+    if (order < minOrder || order > maxOrder) return -1;
+    return order;
+}
+
+int BuddyAllocator::allocate(int bytes) {
+    int order = orderOf(bytes);
+    if (order == -1) return -1;
+
+    // Smallest free block that fits, growing the space if there is none
+    int k = order;
+    while (k <= maxOrder && freeLists[k - minOrder].empty()) k++;
+    if (k > maxOrder) {
+        k = maxOrder;
+        freeLists[k - minOrder].insert(static_cast<int>(reservedBytes));
+        reservedBytes += 1LL << maxOrder;
+    }
+
+    auto& list = freeLists[k - minOrder];
+    int address = *list.begin();  // Lowest address keeps the space compact
+    list.erase(list.begin());
+
+    // Split down, returning the upper halves to the free lists
+    while (k > order) {
+        k--;
+        freeLists[k - minOrder].insert(address + (1 << k));
+    }
+
+    allocatedBytes += bytes;
+    return address;
+}
+
+void BuddyAllocator::free(int address, int bytes) {
+    int order = orderOf(bytes);
+    if (order == -1 || address < 0) return;
+    allocatedBytes -= bytes;
+
+    // Top-level blocks are aligned to the largest size, so the buddy is always address ^ size
+    while (order < maxOrder) {
+        int buddy = address ^ (1 << order);
+        auto& list = freeLists[order - minOrder];
+        auto it = list.find(buddy);
+        if (it == list.end()) break;
+        list.erase(it);
+        if (buddy < address) address = buddy;
+        order++;
+    }
+    freeLists[order - minOrder].insert(address);
+}
+
+int BuddyAllocator::getFreeBlockCount() const {
+    int count = 0;
+    for (const auto& list : freeLists) {
+        count += static_cast<int>(list.size());
+    }
+    return count;
+}
+
+int BuddyAllocator::getLargestFreeBlock() const {
+    for (int k = maxOrder; k >= minOrder; --k) {
+        if (!freeLists[k - minOrder].empty()) return 1 << k;
+    }
+    return 0;
+}
+
+double BuddyAllocator::getFragmentation() const {
+    // No request is larger than one top-level block, so free space beyond that cannot be "fragmented"
+    int64_t usable = std::min<int64_t>(getFreeBytes(), 1LL << maxOrder);
+    if (usable == 0) return 0.0;
+    return 1.0 - static_cast<double>(getLargestFreeBlock()) / usable;
+}
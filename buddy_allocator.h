@@ -0,0 +1,37 @@
+#ifndef BUDDY_ALLOCATOR_H
+#define BUDDY_ALLOCATOR_H
+
+#include <cstdint>
+#include <set>
+#include <vector>
+
+// Header file for buddy_allocator.cpp
+// Hands out power-of-two address ranges from the virtual address space.
+// Each order keeps a sorted free list, so allocate and free are O(log n);
+// a freed block merges with its free buddy up to the largest block size.
+// The space grows by one largest-size block whenever nothing fits.
+class BuddyAllocator {
+public:
+    BuddyAllocator(int minBlockBytes = 64, int maxBlockBytes = 65536);
+
+    int allocate(int bytes);            // Base address, or -1 if bytes is not a supported power of two
+    void free(int address, int bytes);
+
+    int64_t getReservedBytes() const { return reservedBytes; }   // Address space carved out so far
+    int64_t getAllocatedBytes() const { return allocatedBytes; }
+    int64_t getFreeBytes() const { return reservedBytes - allocatedBytes; }
+    int getFreeBlockCount() const;
+    int getLargestFreeBlock() const;    // Bytes, 0 if nothing is free
+    double getFragmentation() const;    // 1 - largest free block / free bytes (capped at the largest block size)
+
+private:
+    int minOrder;
+    int maxOrder;
+    std::vector<std::set<int>> freeLists;  // Indexed by order - minOrder, holding block addresses
+    int64_t reservedBytes = 0;
+    int64_t allocatedBytes = 0;
+
+    int orderOf(int bytes) const;       // -1 if not a power of two in range
+};
+
+#endif
@@ -12,6 +12,11 @@ struct SystemConfig {
     uint32_t minInstructions = 1;
     uint32_t maxInstructions = 1;
     uint32_t delayPerExec = 0;
+    uint32_t tickMillis = 150;      // Wall-clock length of one CPU tick, 0 = fast-forward
+    std::string logFlush = "tick";  // Process log durability: "tick" or "exit"
+    std::string pageReplacement = "fifo";  // fifo, lru, second-chance, clock or working-set
+    uint32_t workingSetWindow = 64;        // References a page stays in the working set
+    uint32_t finishedRetention = 10000;    // Finished-process summaries kept for screen -ls, 0 keeps all
     bool initialized = false;
 };
 
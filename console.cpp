@@ -2,6 +2,8 @@
 #include "scheduler.h"
 #include "process.h"
 #include "config.h"
+#include "process_generator.h"
+#include "memory_manager.h"
 #include <iostream>
 #include <random>
 #include <string>
@@ -11,9 +13,8 @@
 #include <fstream>
 #include <sstream>
 
-// Global RNG
-std::random_device rd;
-std::mt19937 rng(rd());
+// Per-thread RNG (the batch process generator runs on its own thread)
+thread_local std::mt19937 rng(std::random_device{}());
 
 // Random integer between min and max
 int randomInt(int min, int max) {
@@ -59,7 +60,7 @@ List of Commands:
     - scheduler-start
     - scheduler-stop
     - process-smi
-    - vmstat
+    - vmstat [--raw]
     - report-util
     - clear
     - exit
@@ -123,10 +124,10 @@ std::string generateNestedFor(int depth = 0) {
 }
 
 // Randomized instruction list generator
-std::vector<std::string> Console::generateRandomInstructions(const std::string& processName) {
+std::vector<std::string> Console::generateRandomInstructions(const std::string& processName, int count) {
     std::vector<std::string> instructions;
     std::vector<std::string> declaredVars;
-    int count = randomInt(5, 10);
+    instructions.reserve(count);
 
     for (int i = 0; i < count; ++i) {
         int type = randomInt(1,6); // 1-DECLARE, 2-ADD, 3-SUBTRACT, 4-SLEEP, 5-PRINT, 6-FOR
@@ -177,21 +178,10 @@ std::vector<std::string> Console::generateRandomInstructions(const std::string&
     return instructions;
 }
 
-// Initialize test processes with random instructions
+// Start the scheduler along with the background batch process generator
 void Console::initializeTestProcesses() {
-    for (int i = 1; i <= 5; ++i) {
-        std::string name = "process" + std::to_string(i);
-        Process* p = new Process(name, 10000); // 10000 cycles so you can see them executing one by one
-        p->instructions = generateRandomInstructions(name);
-
-        // Print instructions when created
-        for (const auto& instr : p->instructions) {
-            // std::cout << "[" << name << "] Instruction: " << instr << "\n";
-        }
-
-        scheduler.addProcess(p);
-    }
     scheduler.start();
+    processGenerator.start();
 }
 
 void Console::initializeFromConfig() {
@@ -275,12 +265,54 @@ void Console::initializeFromConfig() {
                 return;
             }
             systemConfig.delayPerExec = (uint32_t)v;
+        } else if (key == "tick-ms") {
+            uint64_t v = std::stoull(value);
+            if (v > 4294967295ULL) {
+                std::cout << "Invalid tick-ms, must be 0 to 2^32\n";
+                return;
+            }
+            systemConfig.tickMillis = (uint32_t)v;
+        } else if (key == "log-flush") {
+            std::string mode = value;
+            std::transform(mode.begin(), mode.end(), mode.begin(), ::tolower);
+            if (mode != "tick" && mode != "exit") {
+                std::cout << "Invalid log-flush, must be 'tick' or 'exit'\n";
+                return;
+            }
+            systemConfig.logFlush = mode;
+        } else if (key == "page-replacement") {
+            std::string policy = value;
+            std::transform(policy.begin(), policy.end(), policy.begin(), ::tolower);
+            if (policy != "fifo" && policy != "lru" && policy != "second-chance" && policy != "clock" && policy != "working-set") {
+                std::cout << "Invalid page-replacement, must be 'fifo', 'lru', 'second-chance', 'clock' or 'working-set'\n";
+                return;
+            }
+            systemConfig.pageReplacement = policy;
+        } else if (key == "working-set-window") {
+            uint64_t v = std::stoull(value);
+            if (v < 1 || v > 4294967295ULL) {
+                std::cout << "Invalid working-set-window, must be 1 to 2^32\n";
+                return;
+            }
+            systemConfig.workingSetWindow = (uint32_t)v;
+        } else if (key == "finished-retention") {
+            uint64_t v = std::stoull(value);
+            if (v > 4294967295ULL) {
+                std::cout << "Invalid finished-retention, must be 0 to 2^32\n";
+                return;
+            }
+            systemConfig.finishedRetention = (uint32_t)v;
         } else {
             std::cout << "Unknown config parameter: " << key << "\n";
             return;
         }
     }
 
+    scheduler.setCoreCount(systemConfig.numCPU);
+    scheduler.setPolicy(makeSchedulingPolicy(systemConfig));
+    scheduler.setFinishedRetention(systemConfig.finishedRetention);
+    memManager.setReplacementPolicy(makeReplacementPolicy(systemConfig));
+    memManager.setCoreCount(systemConfig.numCPU);
     systemConfig.initialized = true;
     std::cout << "Configuration loaded successfully.\n";
 }
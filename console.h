@@ -9,9 +9,9 @@ class Console {
 public:
     static void printHeader();              // Prints the command line header
     static std::string acceptCommand();     // Accepts user command
-    static void initializeTestProcesses();  // Runs the test processes
+    static void initializeTestProcesses();  // Starts the scheduler and batch process generator
 
-    static std::vector<std::string> generateRandomInstructions(const std::string& processName); // Added to console.h so it can be called in main
+    static std::vector<std::string> generateRandomInstructions(const std::string& processName, int count); // Added to console.h so it can be called in main
     static void initializeFromConfig(); 
     static void handleScreenCreateCommand(const std::string& command);
 };
@@ -0,0 +1,42 @@
+#include "finished_list.h"
+
+uint64_t FinishedList::firstRetained() const {
+    if (chunks.empty()) return next;
+    uint64_t first = chunks.front()->base;
+    if (retention > 0 && next - first > retention) first = next - retention;
+    return first;
+}
+
+uint64_t FinishedList::append(const ProcessSummary& summary, std::vector<std::shared_ptr<const Chunk>>& dropped) {
+    std::lock_guard<std::mutex> guard(lock);
+    uint64_t record = next++;
+    if (record % CHUNK_RECORDS == 0) {
+        auto chunk = std::make_shared<Chunk>();
+        chunk->base = record;
+        chunks.push_back(std::move(chunk));
+    }
+    chunks.back()->records[record % CHUNK_RECORDS] = summary;
+
+    // A view still reading a dropped chunk keeps it alive until it is done
+    while (retention > 0 && chunks.size() > 1 && next - chunks[1]->base >= retention) {
+        dropped.push_back(chunks.front());
+        chunks.pop_front();
+    }
+    return record;
+}
+
+FinishedList::View FinishedList::snapshot() const {
+    std::lock_guard<std::mutex> guard(lock);
+    View view;
+    view.first = firstRetained();
+    view.end = next;
+    view.chunks.assign(chunks.begin(), chunks.end());
+    return view;
+}
+
+bool FinishedList::find(uint64_t record, ProcessSummary& summary) const {
+    std::lock_guard<std::mutex> guard(lock);
+    if (record < firstRetained() || record >= next) return false;
+    summary = chunks[(record - chunks.front()->base) / CHUNK_RECORDS]->records[record % CHUNK_RECORDS];
+    return true;
+}
@@ -0,0 +1,74 @@
+#ifndef FINISHED_LIST_H
+#define FINISHED_LIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Fixed-size record of a finished process; everything else it held is freed when it finishes
+struct ProcessSummary {
+    static const size_t NAME_LENGTH = 32;
+
+    char name[NAME_LENGTH];         // NUL-terminated, longer names are cut short
+    int pid;                        // Memory manager pid, 0 if it had no memory
+    int core;                       // Core it last ran on
+    int linesExecuted;
+    int totalLines;
+    int preemptions;
+    time_t createdAt;
+    time_t finishedAt;              // For a shut down process, when the violation happened
+    uint64_t pageFaults;
+    uint64_t pageIns;
+    uint64_t pageOuts;
+    bool accessViolation;
+    uint32_t violationAddress;
+};
+
+// Header file for finished_list.cpp
+// Summaries of finished processes in append order, in fixed-size chunks.
+// Only the most recent `retention` records are kept: a chunk is dropped once
+// the newer ones hold that many. Readers take a View, which shares ownership
+// of the chunks it covers, and read it without any lock while cores append.
+class FinishedList {
+public:
+    static const size_t CHUNK_RECORDS = 256;
+
+    struct Chunk {
+        uint64_t base = 0;          // Record number of records[0]
+        ProcessSummary records[CHUNK_RECORDS];
+    };
+
+    // Records [first, end) as of when the view was taken; they never change afterwards
+    struct View {
+        uint64_t first = 0;
+        uint64_t end = 0;
+        std::vector<std::shared_ptr<const Chunk>> chunks;
+
+        size_t size() const { return static_cast<size_t>(end - first); }
+        const ProcessSummary& at(uint64_t record) const {
+            const Chunk& chunk = *chunks[(record - chunks.front()->base) / CHUNK_RECORDS];
+            return chunk.records[record % CHUNK_RECORDS];
+        }
+    };
+
+    void setRetention(size_t records) { retention = records; }   // 0 keeps every record; set while the scheduler is stopped
+
+    // Returns the new record's number; chunks that fell out of retention are handed back in dropped
+    uint64_t append(const ProcessSummary& summary, std::vector<std::shared_ptr<const Chunk>>& dropped);
+    View snapshot() const;                                  // Copies chunk pointers, not records
+    bool find(uint64_t record, ProcessSummary& summary) const;  // False once it is no longer retained
+
+private:
+    mutable std::mutex lock;        // Held only to append a record or copy the chunk list
+    std::deque<std::shared_ptr<Chunk>> chunks;
+    uint64_t next = 0;              // Records ever appended
+    size_t retention = 0;
+
+    uint64_t firstRetained() const;
+};
+
+#endif
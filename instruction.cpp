@@ -0,0 +1,248 @@
+#include "instruction.h"
+#include <unordered_map>
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdlib>
+
+namespace {
+
+// Compile-time state shared by every instruction of one program. FOR bodies make
+// the final size unknown up front, so the program is built here and then copied
+// into its arena at its exact size; the buffers are kept for the next compile.
+struct Compiler {
+    std::vector<Instruction> code;
+    std::vector<std::string> symbols;
+    std::vector<std::string> messages;
+    std::unordered_map<std::string, uint16_t> symbolIndex;
+
+    void reset() {
+        code.clear();
+        symbols.clear();
+        messages.clear();
+        symbolIndex.clear();
+    }
+
+    uint16_t internSymbol(const std::string& name) {
+        auto it = symbolIndex.find(name);
+        if (it != symbolIndex.end()) return it->second;
+        uint16_t index = static_cast<uint16_t>(symbols.size());
+        symbols.push_back(name);
+        symbolIndex[name] = index;
+        return index;
+    }
+
+    void compile(const std::string& text);
+};
+
+std::string trim(const std::string& s) {
+    size_t start = s.find_first_not_of(" \t");
+    if (start == std::string::npos) return "";
+    size_t end = s.find_last_not_of(" \t");
+    return s.substr(start, end - start + 1);
+}
+
+bool startsWith(const std::string& s, const char* prefix) {
+    return s.rfind(prefix, 0) == 0;
+}
+
+// Split on a delimiter, ignoring delimiters nested in brackets, parentheses or quotes
+std::vector<std::string> splitTopLevel(const std::string& s, const std::string& delim) {
+    std::vector<std::string> parts;
+    int depth = 0;
+    bool inQuotes = false;
+    size_t start = 0;
+
+    for (size_t i = 0; i < s.size(); ++i) {
+        char c = s[i];
+        if (c == '"') inQuotes = !inQuotes;
+        if (inQuotes) continue;
+
+        if (c == '(' || c == '[') depth++;
+        else if (c == ')' || c == ']') depth--;
+        else if (depth == 0 && s.compare(i, delim.size(), delim) == 0) {
+            parts.push_back(trim(s.substr(start, i - start)));
+            start = i + delim.size();
+            i = start - 1;
+        }
+    }
+    parts.push_back(trim(s.substr(start)));
+    return parts;
+}
+
+// Returns the text between "OP(" and the final ")", or false if the shape is wrong
+bool extractArgs(const std::string& text, const char* prefix, std::string& args) {
+    size_t open = std::char_traits<char>::length(prefix);
+    if (!startsWith(text, prefix) || text.back() != ')') return false;
+    args = text.substr(open, text.size() - open - 1);
+    return true;
+}
+
+uint16_t clampLiteral(long value) {
+    return static_cast<uint16_t>(std::max(0L, std::min(65535L, value)));
+}
+
+bool isLiteral(const std::string& token) {
+    if (token.empty()) return false;
+    size_t i = (token[0] == '-' || token[0] == '+') ? 1 : 0;
+    return i < token.size() && std::isdigit(static_cast<unsigned char>(token[i]));
+}
+
+bool parseAddress(const std::string& token, uint32_t& address) {
+    if (token.size() < 3 || token.compare(0, 2, "0x") != 0) return false;
+    char* end = nullptr;
+    unsigned long value = std::strtoul(token.c_str() + 2, &end, 16);
+    if (end == token.c_str() + 2) return false;
+    address = static_cast<uint32_t>(value);
+    return true;
+}
+
+Operand makeOperand(Compiler& compiler, const std::string& raw) {
+    Operand operand;
+    std::string token = trim(raw);
+    if (token.empty()) return operand;
+
+    if (isLiteral(token)) {
+        operand.kind = OperandKind::LITERAL;
+        operand.value = clampLiteral(std::strtol(token.c_str(), nullptr, 10));
+    } else {
+        operand.kind = OperandKind::VARIABLE;
+        operand.value = compiler.internSymbol(token);
+    }
+    return operand;
+}
+
+Operand makeVariable(Compiler& compiler, const std::string& raw) {
+    Operand operand;
+    operand.kind = OperandKind::VARIABLE;
+    operand.value = compiler.internSymbol(trim(raw));
+    return operand;
+}
+
+void Compiler::compile(const std::string& source) {
+    std::string text = trim(source);
+    Instruction instr;
+    std::string args;
+
+    if (text.empty()) return;
+
+    if (startsWith(text, "FOR(")) {
+        // FOR([body1 @@ body2 @@ ...], repeats)
+        size_t open = text.find('[');
+        size_t close = text.rfind(']');
+        size_t forIndex = code.size();
+
+        instr.op = OpCode::FOR;
+        code.push_back(instr);
+        if (open == std::string::npos || close == std::string::npos || close < open) return;
+
+        std::string tail = text.substr(close + 1);
+        size_t digits = tail.find_first_of("0123456789");
+        if (digits == std::string::npos) return;
+
+        for (const auto& body : splitTopLevel(text.substr(open + 1, close - open - 1), "@@")) {
+            compile(body);
+        }
+
+        code[forIndex].imm = static_cast<uint32_t>(std::strtoul(tail.c_str() + digits, nullptr, 10));
+        code[forIndex].span = static_cast<uint32_t>(code.size() - forIndex - 1);
+        return;
+    }
+
+    if (extractArgs(text, "PRINT(", args)) {
+        // PRINT("message") or PRINT("message" + operand)
+        size_t first = args.find('"');
+        size_t second = (first == std::string::npos) ? std::string::npos : args.find('"', first + 1);
+        if (first == 0 && second != std::string::npos) {
+            std::string rest = trim(args.substr(second + 1));
+            if (rest.empty() || rest[0] == '+') {
+                instr.op = OpCode::PRINT;
+                instr.imm = static_cast<uint32_t>(messages.size());
+                messages.push_back(args.substr(1, second - 1));
+                if (!rest.empty()) instr.args[0] = makeOperand(*this, rest.substr(1));
+            }
+        }
+    } else if (extractArgs(text, "DECLARE(", args)) {
+        auto parts = splitTopLevel(args, ",");
+        if (parts.size() == 2 && !parts[0].empty() && !parts[1].empty()) {
+            instr.op = OpCode::DECLARE;
+            instr.args[0] = makeVariable(*this, parts[0]);
+            instr.args[1] = makeOperand(*this, parts[1]);
+        }
+    } else if (extractArgs(text, "ADD(", args) || extractArgs(text, "SUBTRACT(", args)) {
+        auto parts = splitTopLevel(args, ",");
+        if (parts.size() == 3 && !parts[0].empty() && !parts[1].empty() && !parts[2].empty()) {
+            instr.op = startsWith(text, "ADD(") ? OpCode::ADD : OpCode::SUBTRACT;
+            instr.args[0] = makeVariable(*this, parts[0]);
+            instr.args[1] = makeOperand(*this, parts[1]);
+            instr.args[2] = makeOperand(*this, parts[2]);
+        }
+    } else if (extractArgs(text, "SLEEP(", args)) {
+        std::string ticks = trim(args);
+        if (!ticks.empty() && std::all_of(ticks.begin(), ticks.end(), ::isdigit)) {
+            instr.op = OpCode::SLEEP;
+            instr.imm = static_cast<uint32_t>(std::strtoul(ticks.c_str(), nullptr, 10));
+        }
+    } else if (startsWith(text, "READ") || startsWith(text, "WRITE")) {
+        // READ var 0xADDR / WRITE 0xADDR value (parenthesised forms are accepted too)
+        std::string spaced = text;
+        std::replace_if(spaced.begin(), spaced.end(), [](char c) {
+            return c == '(' || c == ')' || c == ',';
+        }, ' ');
+        auto tokens = splitTopLevel(trim(spaced), " ");
+        tokens.erase(std::remove(tokens.begin(), tokens.end(), ""), tokens.end());
+
+        if (tokens.size() == 3 && tokens[0] == "READ" && parseAddress(tokens[2], instr.imm)) {
+            instr.op = OpCode::READ;
+            instr.args[0] = makeVariable(*this, tokens[1]);
+        } else if (tokens.size() == 3 && tokens[0] == "WRITE" && parseAddress(tokens[1], instr.imm)) {
+            instr.op = OpCode::WRITE;
+            instr.args[1] = makeOperand(*this, tokens[2]);
+        }
+    }
+
+    code.push_back(instr);
+}
+
+} // namespace
+
+void Program::clear() {
+    // Swapping in empty vectors keeps them from touching the blocks after release()
+    std::pmr::vector<Instruction>(&arena).swap(code);
+    std::pmr::vector<std::pmr::string>(&arena).swap(symbols);
+    std::pmr::vector<std::pmr::string>(&arena).swap(messages);
+    arena.release();
+}
+
+// Upper bound on what a compiled program takes from its arena, so it fits in one block
+static size_t arenaFootprint(const Compiler& compiler) {
+    const size_t align = alignof(std::max_align_t);
+    const size_t inlineChars = std::pmr::string().capacity();   // Shorter strings need no allocation
+    auto padded = [&](size_t bytes) { return (bytes + align - 1) / align * align; };
+
+    size_t bytes = padded(compiler.code.size() * sizeof(Instruction));
+    bytes += padded(compiler.symbols.size() * sizeof(std::pmr::string));
+    bytes += padded(compiler.messages.size() * sizeof(std::pmr::string));
+    bytes += padded(compiler.symbols.size());                   // The symbol table's slot map
+    for (const auto* strings : {&compiler.symbols, &compiler.messages}) {
+        for (const auto& text : *strings) {
+            if (text.size() > inlineChars) bytes += padded(text.size() + 1);
+        }
+    }
+    return bytes;
+}
+
+void compileProgram(const std::vector<std::string>& source, Program& program) {
+    thread_local Compiler compiler;
+    compiler.reset();
+    for (const auto& text : source) {
+        compiler.compile(text);
+    }
+
+    program.arena.reserve(arenaFootprint(compiler));
+    program.code.assign(compiler.code.begin(), compiler.code.end());
+    program.symbols.reserve(compiler.symbols.size());
+    for (const auto& name : compiler.symbols) program.symbols.emplace_back(name);
+    program.messages.reserve(compiler.messages.size());
+    for (const auto& message : compiler.messages) program.messages.emplace_back(message);
+}
@@ -0,0 +1,60 @@
+#ifndef INSTRUCTION_H
+#define INSTRUCTION_H
+
+#include "program_arena.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Header file for instruction.cpp
+// Instructions are decoded once when a process is created so the scheduler
+// never has to parse instruction strings while the process is running.
+
+enum class OpCode : uint8_t {
+    NOP,        // Unrecognised or malformed instruction (still consumes a line)
+    PRINT,
+    DECLARE,
+    ADD,
+    SUBTRACT,
+    SLEEP,
+    FOR,        // Followed inline by `span` body instructions
+    READ,
+    WRITE
+};
+
+enum class OperandKind : uint8_t {
+    NONE,
+    LITERAL,    // value holds the literal itself
+    VARIABLE    // value holds the symbol table slot (index into Program::symbols)
+};
+
+struct Operand {
+    OperandKind kind = OperandKind::NONE;
+    uint16_t value = 0;
+};
+
+struct Instruction {
+    OpCode op = OpCode::NOP;
+    Operand args[3];        // DECLARE/ADD/SUBTRACT/READ: args[0] is the target variable
+    uint32_t imm = 0;       // SLEEP ticks, FOR repeats, READ/WRITE address, PRINT message index
+    uint32_t span = 0;      // FOR: number of body instructions that follow
+};
+
+// Everything a program owns lives in its arena, so clear() frees it in one step
+struct Program {
+    ProgramArena arena;
+    std::pmr::vector<Instruction> code{&arena};
+    std::pmr::vector<std::pmr::string> symbols{&arena};   // Variable names, in slot order
+    std::pmr::vector<std::pmr::string> messages{&arena};  // PRINT string literals
+
+    Program() = default;
+    Program(const Program&) = delete;
+    Program& operator=(const Program&) = delete;
+
+    bool empty() const { return code.empty(); }
+    void clear();                       // Drop the program and return its blocks to the pool
+};
+
+void compileProgram(const std::vector<std::string>& source, Program& program);  // Decode instruction strings into an empty program
+
+#endif
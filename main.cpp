@@ -4,6 +4,8 @@
 #include "variable_manager.h"
 #include "memory_manager.h"
 #include "process.h"
+#include "process_generator.h"
+#include "process_pool.h"
 #include <regex>
 #include <iostream>
 #include <sstream>
@@ -30,9 +32,13 @@ void enterProcessScreen(Process* process) {
     std::cout << "Total Lines   : " << process->totalLines << "\n";
     std::cout << "Current Line  : " << process->currentLine << "\n";
     std::cout << "Core Assigned : " << (process->coreAssigned >= 0 ? std::to_string(process->coreAssigned) : "None") << "\n";
+    std::cout << "State         : " << processStateName(process->state) << "\n";
     std::cout << "Sleeping      : " << (process->isSleeping() ? "Yes" : "No") << "\n";
     std::cout << "Finished      : " << (process->isFinished ? "Yes" : "No") << "\n";
     std::cout << "============================\n";
+    for (const auto& entry : process->recentLogs()) {
+        std::cout << entry << "\n";
+    }
 
     // Clear any leftover input before starting the loop
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
@@ -46,14 +52,25 @@ void enterProcessScreen(Process* process) {
         if (cmd == "exit") break;
         else if (cmd == "process-smi") {
             std::cout << "Current instruction line: " << process->currentLine << " / " << process->totalLines << "\n";
+            std::cout << "State: " << processStateName(process->state) << "\n";
             std::cout << "Sleeping: " << (process->isSleeping() ? "Yes" : "No") << "\n";
             std::cout << "Finished: " << (process->isFinished ? "Yes" : "No") << "\n";
+            std::cout << "Logs:\n";
+            for (const auto& entry : process->recentLogs()) {
+                std::cout << "  " << entry << "\n";
+            }
         } else {
             std::cout << "Unknown command inside process screen.\n";
         }
     }
 }
 
+void printAccessViolation(const std::string& name, time_t time, uint32_t address) {
+    std::cout << "Process " << name << " shut down due to memory access violation error that occurred at "
+              << formatTimestamp(time) << ". 0x" << std::uppercase << std::hex << address
+              << std::dec << std::nouppercase << " invalid.\n";
+}
+
 // Main command interpreter
 void verifyCommand(const std::string& input) {
     if (!systemConfig.initialized) {
@@ -117,19 +134,14 @@ void verifyCommand(const std::string& input) {
         }
 
         Process* p = new Process(process_name, instructions.size());
-        p->instructions = instructions;
+        p->setInstructions(instructions);
         p->pid = pid;
 
         // Assign baseAddr and limitAddr from MemoryManager's record for this process
-        const auto& processes = memManager.getProcesses();
-        auto it = processes.find(process_name);
-        if (it == processes.end()) {
+        if (!memManager.getProcessRange(process_name, p->baseAddr, p->limitAddr)) {
             std::cout << "[ERROR] Process info not found for " << process_name << "\n";
             return;
         }
-        const auto& procMem = it->second;
-        p->baseAddr = procMem.baseAddr;
-        p->limitAddr = procMem.allocatedBytes;
 
         scheduler.addProcess(p);
 
@@ -167,15 +179,10 @@ void verifyCommand(const std::string& input) {
         process->pid = pid;
 
         // Assign baseAddr and limitAddr
-        const auto& processes = memManager.getProcesses();
-        auto it = processes.find(name);
-        if (it == processes.end()) {
+        if (!memManager.getProcessRange(name, process->baseAddr, process->limitAddr)) {
             std::cout << "[ERROR] Process memory info not found for " << name << "\n";
             return;
         }
-        const auto& procMem = it->second;
-        process->baseAddr = procMem.baseAddr;
-        process->limitAddr = procMem.allocatedBytes;
 
 
         scheduler.addProcess(process);
@@ -187,13 +194,27 @@ void verifyCommand(const std::string& input) {
 
     else if (input.rfind("screen -r", 0) == 0) {
         if (input.size() <= 10) {
-            std::cout << "Please provide a process name. Usage: screen -r <name>\n";
+            std::cout << "Please provide a process name. Usage: screen -r <name|pid>\n";
             return;
         }
         std::string processName = input.substr(10);
         Process* process = scheduler.findProcess(processName);
+        // Not a name: a number is taken as the pid shown by process-smi
+        if (!process && processName.find_first_not_of("0123456789") == std::string::npos && processName.size() < 10) {
+            process = scheduler.findProcessByPid(std::stoi(processName));
+            if (process) processName = process->name;
+        }
 
-        if (!process || process->isFinished) {
+        ProcessSummary summary;
+        if (process && process->accessViolation) {
+            printAccessViolation(process->name, process->violationTime, process->violationAddress);
+            return;
+        }
+        if (!process && scheduler.findFinished(processName, summary) && summary.accessViolation) {
+            printAccessViolation(processName, summary.finishedAt, summary.violationAddress);
+            return;
+        }
+        if (!process || process->state == ProcessState::FINISHED) {
             std::cout << "Process " << processName << " not found.\n";
             return;
         }
@@ -215,12 +236,20 @@ void verifyCommand(const std::string& input) {
         scheduler.printStatus();
     } else if (input == "scheduler-stop") {
         std::cout << "Stopping scheduler..." << std::endl;
+        processGenerator.stop();
         scheduler.stop();
     } else if (input == "process-smi") {
         memManager.printProcessSMI();
     } 
     else if (input == "vmstat") {
-        memManager.printVMStat();
+        uint64_t activeTicks, idleTicks;
+        scheduler.getCpuTicks(activeTicks, idleTicks);
+        memManager.printVMStat(activeTicks, idleTicks);
+    } else if (input == "vmstat --raw") {
+        memManager.writeCounters(std::cout);
+        scheduler.writeCounters(std::cout);
+        processPool.writeCounters(std::cout);
+        programBlocks.writeCounters(std::cout);
     } else if (input == "report-util") {
         scheduler.saveStatusToFile("C:/csopesy-log.txt");
     } else if (input == "clear") {
@@ -231,6 +260,7 @@ void verifyCommand(const std::string& input) {
         #endif
         Console::printHeader();
     } else if (input == "exit") {
+        processGenerator.stop();
         scheduler.stop();
         std::cout << "Exiting..." << std::endl;
         exit(0);
@@ -244,6 +274,7 @@ int main() {
     Console::printHeader();
     std::string command;
     while (true) {
+        scheduler.reclaimRetired();     // No Process* from the previous command is still in use here
         command = Console::acceptCommand();
         verifyCommand(command);
     }
@@ -5,30 +5,63 @@
 #include <sstream>
 #include <fstream>
 #include <cstdint>
+#include <cstring>
+#include <thread>
 
 MemoryManager memManager; // Global instance
 
 MemoryManager::MemoryManager(int totalMemoryBytes, int pageSize)
     : totalMemory(totalMemoryBytes), pageSize(pageSize) {
     frameCount = totalMemory / pageSize;
-    frames.resize(frameCount, "EMPTY");
+    frames.assign(frameCount, FREE_FRAME);
+    framePages.assign(frameCount, nullptr);
+    physicalMemory.assign(static_cast<size_t>(frameCount) * pageSize, 0);
+    zeroPage.assign(pageSize, 0);
+
+    // Pushed in reverse so frame 0 is handed out first
+    freeFrames.reserve(frameCount);
+    for (int i = frameCount - 1; i >= 0; --i) {
+        freeFrames.push_back(i);
+    }
 
     initializeBackingStore();
+    setReplacementPolicy(std::make_unique<FIFOReplacement>());
+    setCoreCount(1);
+}
 
-    // Open backing store for appending page writes later
-    backingStore.open("csopesy-backing-store.txt", std::ios::app);
-    if (!backingStore.is_open()) {
-        std::cerr << "Failed to open backing store.\n";
+void MemoryManager::setCoreCount(int count) {
+    std::lock_guard<std::mutex> frameLock(frameMutex);
+    drainHints();
+    for (auto& cpu : cores) {
+        retiredReferences += cpu->references.load();
+    }
+    cores.clear();
+    for (int i = 0; i < count; ++i) {
+        cores.push_back(std::make_unique<CoreMemory>());
     }
 }
 
 void MemoryManager::initializeBackingStore() {
-    // Clear backing store file on startup
-    std::ofstream clearFile("csopesy-backing-store.txt", std::ios::trunc);
-    if (!clearFile.is_open()) {
-        std::cerr << "Failed to clear backing store.\n";
+    // Binary file of pageSize slots, emptied on startup
+    backingStore.open("csopesy-backing-store.txt", pageSize);
+}
+
+void MemoryManager::setReplacementPolicy(std::unique_ptr<ReplacementPolicy> policy) {
+    std::lock_guard<std::mutex> frameLock(frameMutex);
+    drainHints();
+
+    uint64_t now = referenceTime();
+    if (activeStats) activeStats->references += now - activeSince;
+    activeSince = now;
+
+    replacement = std::move(policy);
+    replacement->reset(frameCount);
+    activeStats = &replacementStats[replacement->name()];
+
+    // Hand the pages already in memory to the new policy
+    for (int i = 0; i < frameCount; ++i) {
+        if (frames[i] != FREE_FRAME) replacement->onLoad(i, now);
     }
-    clearFile.close();
 }
 
 int MemoryManager::allocateProcess(const std::string& processName, int memoryBytes) {
@@ -39,184 +72,530 @@ int MemoryManager::allocateProcess(const std::string& processName, int memoryByt
 
     int pageCount = (memoryBytes + pageSize - 1) / pageSize;
 
-    ProcessMemory proc;
-    proc.pid = static_cast<int>(processes.size()) + 1;
+    std::unique_lock<std::shared_mutex> registryLock(registryMutex);
+    auto [it, inserted] = processes.try_emplace(processName);
+    if (!inserted) {
+        std::cerr << "[ERROR] Process " << processName << " already has memory allocated\n";
+        return -1;
+    }
+
+    // Built in place: the page table lock cannot be moved
+    ProcessMemory& proc = it->second;
+    proc.pid = nextPid++;
     proc.processName = processName;
     proc.allocatedBytes = memoryBytes;
     proc.pageCount = pageCount;
-    proc.pageTable.resize(pageCount);
+    proc.baseAddr = addressSpace.allocate(memoryBytes);
+    processesByPid[proc.pid] = &proc;
+    int pid = proc.pid;
+    registryLock.unlock();
+
+    std::cout << "[MEM] Allocated " << memoryBytes << " bytes (" << pageCount << " page(s)) to process " << processName << "\n";
+    return pid;
+}
+
+void MemoryManager::accessPage(int core, int pid, int pageNumber) {
+    if (pageNumber < 0) return;
+    access(core, pid, static_cast<uint32_t>(pageNumber) * pageSize, Access::FETCH, nullptr, 0);
+}
 
-    // Initialize each page's data with zero bytes
-    for (auto& page : proc.pageTable) {
-        page.data.resize(pageSize, 0);
+bool MemoryManager::readWord(int core, int pid, uint32_t address, uint16_t& value) {
+    uint8_t bytes[2];
+    if ((address + 1) % pageSize) {
+        if (!access(core, pid, address, Access::READ, bytes, 2)) return false;
+    } else {
+        // The word spills into the next page, whose fault may evict this one: read a byte at a time
+        if (!access(core, pid, address, Access::READ, bytes, 1)) return false;
+        if (!access(core, pid, address + 1, Access::READ, bytes + 1, 1)) return false;
     }
+    value = static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+    return true;
+}
 
-    int nextBaseAddr = 0;
-    for (const auto& [_, existingProc] : processes) {
-        int endAddr = existingProc.baseAddr + existingProc.allocatedBytes;
-        if (endAddr > nextBaseAddr) nextBaseAddr = endAddr;
+bool MemoryManager::writeWord(int core, int pid, uint32_t address, uint16_t value) {
+    uint8_t bytes[2] = { static_cast<uint8_t>(value & 0xFF), static_cast<uint8_t>(value >> 8) };
+    if ((address + 1) % pageSize) {
+        return access(core, pid, address, Access::WRITE, bytes, 2);
     }
-    proc.baseAddr = nextBaseAddr;
 
-    processes[processName] = proc;
+    // Spans two pages: validate the second before storing anything, then store a byte at a time
+    uint8_t probe;
+    if (!access(core, pid, address + 1, Access::READ, &probe, 1)) return false;
+    if (!access(core, pid, address, Access::WRITE, bytes, 1)) return false;
+    return access(core, pid, address + 1, Access::WRITE, bytes + 1, 1);
+}
 
-    std::cout << "[MEM] Allocated " << memoryBytes << " bytes (" << pageCount << " page(s)) to process " << processName << "\n";
-    return proc.pid;
+void MemoryManager::copyBytes(int frameIndex, int offset, Access kind, uint8_t* data, int count) {
+    if (kind == Access::READ) {
+        std::memcpy(data, frameData(frameIndex) + offset, count);
+    } else if (kind == Access::WRITE) {
+        std::memcpy(frameData(frameIndex) + offset, data, count);
+    }
 }
 
-void MemoryManager::accessPage(const std::string& processName, int pageNumber) {
-    if (!processes.count(processName)) return;
+bool MemoryManager::access(int core, int pid, uint32_t address, Access kind, uint8_t* data, int count) {
+    if (pid <= 0) return false;  // Process has no memory allocated
+    int pageNumber = static_cast<int>(address / pageSize);
+    int offset = static_cast<int>(address % pageSize);
+    if (pageNumber > 0xFFFF) return false;  // Beyond any process, and the TLB's page field
+
+    // Hit: the cached frame stays valid until the copy is done, since an eviction
+    // shoots the entry down and then waits for this core to leave the access.
+    // A zero-page mapping only satisfies reads; a fetch or write takes the slow path to get a frame.
+    CoreMemory& cpu = *cores[static_cast<size_t>(core) % cores.size()];
+    cpu.tlb.beginAccess();
+    int frame = cpu.tlb.lookup(pid, pageNumber);
+    if (frame >= 0 && (frame != ZERO_FRAME || kind == Access::READ)) {
+        uint64_t reference = countReference(cpu);
+        if (frame != ZERO_FRAME) {
+            recordHint(cpu, frame, packFrame(pid, pageNumber), reference);
+            if (kind == Access::WRITE) framePages[frame]->dirty = true;
+        }
+        copyBytes(frame, offset, kind, data, count);
+        cpu.tlb.endAccess();
+        return true;
+    }
+    cpu.tlb.endAccess();
 
-    auto& proc = processes[processName];
-    if (pageNumber >= proc.pageCount) return;
+    return accessSlow(cpu, pid, pageNumber, offset, kind, data, count);
+}
 
-    auto& page = proc.pageTable[pageNumber];
+bool MemoryManager::accessSlow(CoreMemory& cpu, int pid, int pageNumber, int offset, Access kind, uint8_t* data, int count) {
+    std::shared_lock<std::shared_mutex> registryLock(registryMutex);
+    auto it = processesByPid.find(pid);
+    if (it == processesByPid.end()) return false;
+
+    auto& proc = *it->second;
+    if (pageNumber >= proc.pageCount) return false;
+
+    std::lock_guard<std::mutex> procLock(proc.lock);
+    uint64_t reference = countReference(cpu);
+    uint64_t now = referenceTime();
+
+    // A page with no frame and no backing store slot has never been written back, so it is all zeros
+    auto existing = proc.pageTable.find(pageNumber);
+    bool zeroFilled = existing == proc.pageTable.end() || (!existing->second.inMemory && existing->second.swapSlot < 0);
+    if (zeroFilled && kind == Access::READ) {
+        totals.zeroPageMaps++;
+        proc.counters.zeroPageMaps++;
+        copyBytes(ZERO_FRAME, offset, kind, data, count);
+        cpu.tlb.insert(pid, pageNumber, ZERO_FRAME);
+        return true;
+    }
 
+    auto& page = existing != proc.pageTable.end() ? existing->second : proc.pageTable[pageNumber];
     if (!page.inMemory) {
-        std::cout << "[PAGE FAULT] Loading page " << pageNumber << " of " << processName << " into memory...\n";
-        pageIn(processName, pageNumber);
+        std::cout << "[PAGE FAULT] Loading page " << pageNumber << " of " << proc.processName << " into memory...\n";
+        totals.faults++;
+        proc.counters.faults++;
+        pageIn(proc, pageNumber, page, now);
+    } else {
+        recordHint(cpu, page.frameIndex, packFrame(pid, pageNumber), reference);
     }
+    if (kind == Access::WRITE) page.dirty = true;
+
+    // Other cores cannot evict this page while its lock is held, so the copy needs no TLB bracket
+    copyBytes(page.frameIndex, offset, kind, data, count);
+    cpu.tlb.insert(pid, pageNumber, page.frameIndex);
+    return true;
+}
+
+uint64_t MemoryManager::countReference(CoreMemory& cpu) {
+    // Only the owning core writes its count, so a plain store does; no cache line is shared with other cores
+    uint64_t count = cpu.references.load(std::memory_order_relaxed) + 1;
+    cpu.references.store(count, std::memory_order_relaxed);
+    return count;
 }
 
-void MemoryManager::pageIn(const std::string& processName, int pageNumber) {
-    int frame = findFreeFrame();
-    if (frame == -1) {
-        frame = replacePage();
+uint64_t MemoryManager::referenceTime() const {
+    uint64_t total = retiredReferences.load(std::memory_order_relaxed);
+    for (const auto& cpu : cores) {
+        total += cpu->references.load(std::memory_order_relaxed);
     }
+    return total;
+}
 
-    frames[frame] = processName + "@" + std::to_string(pageNumber);
-    pageHistory.push_back(frames[frame]);
+void MemoryManager::recordHint(CoreMemory& cpu, int frameIndex, uint64_t entry, uint64_t time) {
+    size_t tail = cpu.hintTail.load(std::memory_order_relaxed);
+    if (tail - cpu.hintHead.load(std::memory_order_acquire) >= CoreMemory::HINT_CAPACITY) {
+        // Full: replay the backlog now if nobody is faulting, otherwise lose this one reference
+        std::unique_lock<std::mutex> frameLock(frameMutex, std::try_to_lock);
+        if (!frameLock.owns_lock()) return;
+        drainHints();
+    }
+    cpu.hints[tail & (CoreMemory::HINT_CAPACITY - 1)] = { frameIndex, entry, time };
+    cpu.hintTail.store(tail + 1, std::memory_order_release);
+}
 
-    auto& proc = processes[processName];
-    auto& page = proc.pageTable[pageNumber];
-    page.inMemory = true;
-    page.frameIndex = frame;
+void MemoryManager::drainHints() {
+    // Each core's references since the last replay are laid over the same stretch of policy time,
+    // as if the cores had run side by side, and that time then moves on by all of them together
+    uint64_t base = policyTime;
+    for (auto& cpu : cores) {
+        size_t head = cpu->hintHead.load(std::memory_order_relaxed);
+        size_t tail = cpu->hintTail.load(std::memory_order_acquire);
+        uint64_t references = cpu->references.load(std::memory_order_relaxed);  // Covers every hint up to tail
+        for (; head != tail; ++head) {
+            const AccessHint& hint = cpu->hints[head & (CoreMemory::HINT_CAPACITY - 1)];
+            uint64_t time = base + (hint.time - cpu->replayedReferences);
+            if (frames[hint.frame] == hint.entry) replacement->onAccess(hint.frame, time);
+        }
+        cpu->hintHead.store(head, std::memory_order_release);
+        policyTime += references - cpu->replayedReferences;
+        cpu->replayedReferences = references;
+    }
+}
 
-    // Mark as dirty because page loaded from backing store (simulate)
+void MemoryManager::pageIn(ProcessMemory& proc, int pageNumber, Page& page, uint64_t now) {
+    int frame = claimFrame(proc, pageNumber, page, now);
+    totals.pageIns++;
+    proc.counters.pageIns++;
+
+    // Bring back the contents saved when the page was last written back; never-written pages read as zero.
+    // Only this process's lock is held from here on, so faults of other processes load in parallel.
+    if (page.swapSlot >= 0) {
+        readPageFromBackingStore(proc.processName, pageNumber, page, frame);
+    } else {
+        // Other cores may still map this page to the zero page
+        shootdown(proc.pid, pageNumber);
+        std::fill(frameData(frame), frameData(frame) + pageSize, 0);
+    }
+    page.frameIndex = frame;
+    page.inMemory = true;
     page.dirty = false;
-
-    // Write a log to backing store to indicate load (optional)
-    backingStore << "[LOAD] " << processName << " page " << pageNumber << " -> frame " << frame << "\n";
-    backingStore.flush();
 }
 
-void MemoryManager::pageOut(int frameIndex) {
-    std::string tag = frames[frameIndex];
-    if (tag == "EMPTY") return;
-
-    auto pos = tag.find('@');
-    std::string procName = tag.substr(0, pos);
-    int pageIdx = std::stoi(tag.substr(pos + 1));
-
-    auto& page = processes[procName].pageTable[pageIdx];
-    page.inMemory = false;
-    page.frameIndex = -1;
-
-    // Write page data to backing store on eviction
-    writePageToBackingStore(procName, pageIdx, page.data);
+int MemoryManager::claimFrame(ProcessMemory& proc, int pageNumber, Page& page, uint64_t now) {
+    while (true) {
+        std::unique_lock<std::mutex> frameLock(frameMutex);
+        drainHints();
+        activeStats->faults++;
+
+        int frame = -1;
+        std::unique_lock<std::mutex> ownerLock;
+        std::vector<int> skipped;           // Victims whose owner was busy, handed back once one is chosen
+        if (!freeFrames.empty()) {
+            frame = freeFrames.back();
+            freeFrames.pop_back();
+            usedFrames++;
+        } else {
+            // The victim's owner may be mid-fault: skip pages whose table we cannot lock right now
+            for (int attempt = 0; attempt < frameCount && frame == -1; ++attempt) {
+                int victim = replacement->selectVictim(now);
+                if (victim < 0) break;
+
+                ProcessMemory& owner = *processesByPid.at(framePid(frames[victim]));
+                if (&owner != &proc) {
+                    ownerLock = std::unique_lock<std::mutex>(owner.lock, std::try_to_lock);
+                    if (!ownerLock.owns_lock()) {
+                        skipped.push_back(victim);
+                        continue;
+                    }
+                }
+                frame = victim;
+            }
+            // In reverse, so queue-based policies get them back in their original order
+            for (auto it = skipped.rbegin(); it != skipped.rend(); ++it) {
+                replacement->requeue(*it);
+            }
+        }
 
-    backingStore << "[EVICT] " << procName << " page " << pageIdx << " from frame " << frameIndex << "\n";
-    backingStore.flush();
+        if (frame == -1) {
+            // Every resident page belongs to a process that is faulting right now; let one finish
+            activeStats->faults--;
+            frameLock.unlock();
+            std::this_thread::yield();
+            continue;
+        }
 
-    frames[frameIndex] = "EMPTY";
-}
+        // Wait out TLB hits on the old page before the frame changes hands
+        Page* evicted = framePages[frame];
+        uint64_t evictedEntry = frames[frame];
+        if (evicted) {
+            shootdown(framePid(evictedEntry), framePage(evictedEntry));
+            evicted->inMemory = false;
+            evicted->frameIndex = -1;
+            activeStats->evictions++;
+        }
 
-int MemoryManager::findFreeFrame() {
-    for (int i = 0; i < frameCount; ++i) {
-        if (frames[i] == "EMPTY") return i;
+        // The victim's frame goes straight to the faulting page instead of the free stack
+        frames[frame] = packFrame(proc.pid, pageNumber);
+        framePages[frame] = &page;
+        replacement->onLoad(frame, now);
+        if (!evicted) return frame;
+
+        // Write the old page back without blocking other faults; its owner's lock is still held
+        frameLock.unlock();
+
+        ProcessMemory& owner = *processesByPid.at(framePid(evictedEntry));
+        totals.pageOuts++;
+        owner.counters.pageOuts++;
+
+        // Only a modified page needs writing; a clean one matches its slot (or is still all zero)
+        if (evicted->dirty) {
+            writePageToBackingStore(owner.processName, framePage(evictedEntry), *evicted, frame);
+            evicted->dirty = false;
+            totals.dirtyWriteBacks++;
+            owner.counters.dirtyWriteBacks++;
+        }
+        return frame;
     }
-    return -1;
 }
 
-int MemoryManager::replacePage() {
-    std::string oldest = pageHistory.front();
-    pageHistory.erase(pageHistory.begin());
-
-    auto pos = oldest.find('@');
-    std::string procName = oldest.substr(0, pos);
-    int pageIdx = std::stoi(oldest.substr(pos + 1));
-
-    int frameIndex = processes[procName].pageTable[pageIdx].frameIndex;
-    pageOut(frameIndex);
-    return frameIndex;
+void MemoryManager::releaseFrame(int frameIndex) {
+    shootdown(framePid(frames[frameIndex]), framePage(frames[frameIndex]));
+    replacement->onRelease(frameIndex);
+    framePages[frameIndex] = nullptr;
+    frames[frameIndex] = FREE_FRAME;
+    usedFrames--;
+    freeFrames.push_back(frameIndex);
 }
 
-void MemoryManager::deallocateProcess(const std::string& processName) {
-    if (!processes.count(processName)) return;
+void MemoryManager::shootdown(int pid, int pageNumber) {
+    for (auto& cpu : cores) {
+        cpu->tlb.invalidate(pid, pageNumber);
+    }
+    // A core that looked the entry up before it was cleared may still be copying through it
+    for (auto& cpu : cores) {
+        cpu->tlb.waitUntilIdle();
+    }
+    tlbShootdowns++;
+}
 
-    auto& proc = processes[processName];
-    for (int i = 0; i < proc.pageCount; ++i) {
-        if (proc.pageTable[i].inMemory) {
-            pageOut(proc.pageTable[i].frameIndex);
+void MemoryManager::deallocateProcess(const std::string& processName, PagingSummary* summary) {
+    // Exclusive, so no fault is in progress and none can pick this process's pages as victims
+    std::unique_lock<std::shared_mutex> registryLock(registryMutex);
+    auto it = processes.find(processName);
+    if (it == processes.end()) return;
+
+    // Zero-page TLB entries are not tracked, but pids are never reused so they can no longer hit
+    auto& proc = it->second;
+    {
+        std::lock_guard<std::mutex> frameLock(frameMutex);
+        drainHints();
+        for (auto& [_, page] : proc.pageTable) {
+            if (page.inMemory) {
+                // The contents are being discarded, so release the frame without writing it back
+                releaseFrame(page.frameIndex);
+            }
         }
     }
+    for (auto& [_, page] : proc.pageTable) {
+        backingStore.freeSlot(page.swapSlot);
+    }
 
-    processes.erase(processName);
+    if (summary) {
+        summary->faults = proc.counters.faults;
+        summary->pageIns = proc.counters.pageIns;
+        summary->pageOuts = proc.counters.pageOuts;
+    }
+
+    addressSpace.free(proc.baseAddr, proc.allocatedBytes);
+    processesByPid.erase(proc.pid);
+    processes.erase(it);
+    registryLock.unlock();
     std::cout << "[MEM] Deallocated memory of " << processName << "\n";
 }
 
-void MemoryManager::writePageToBackingStore(const std::string& processName, int pageNumber, const std::vector<uint8_t>& pageData) {
-    if (!backingStore.is_open()) {
-        std::cerr << "[ERROR] Backing store file not open for writing.\n";
+void MemoryManager::writePageToBackingStore(const std::string& processName, int pageNumber, Page& page, int frameIndex) {
+    // A page keeps its slot for life, so rewriting it never grows the file
+    if (page.swapSlot < 0) page.swapSlot = backingStore.allocateSlot();
+    if (!backingStore.writeSlot(page.swapSlot, frameData(frameIndex))) {
+        std::cerr << "[ERROR] Failed to write page " << pageNumber << " of " << processName << " to backing store.\n";
         return;
     }
-    // Format: process,page,data bytes as hex
-    backingStore << processName << "," << pageNumber << ",";
-    for (auto byte : pageData) {
-        backingStore << std::hex << std::setw(2) << std::setfill('0') << (int)byte << " ";
-    }
-    backingStore << "\n";
-    backingStore.flush();
 
     std::cout << "[BackingStore] Written page " << pageNumber << " of " << processName << "\n";
 }
 
-void MemoryManager::printProcessSMI() {
-    std::cout << "\n========== process-smi ==========\n";
-    std::cout << "Total Memory: " << totalMemory << " bytes (" << frameCount << " frames)\n";
-    int used = std::count_if(frames.begin(), frames.end(), [](const std::string& s) { return s != "EMPTY"; });
-    std::cout << "Used Frames : " << used << "\n";
-    std::cout << "Free Frames : " << (frameCount - used) << "\n";
+void MemoryManager::readPageFromBackingStore(const std::string& processName, int pageNumber, Page& page, int frameIndex) {
+    if (!backingStore.readSlot(page.swapSlot, frameData(frameIndex))) {
+        std::cerr << "[ERROR] Failed to read page " << pageNumber << " of " << processName << " from backing store.\n";
+    }
+}
 
-    std::cout << "\nFrame Table:\n";
-    for (int i = 0; i < frameCount; ++i) {
-        std::cout << "  Frame[" << std::setw(2) << i << "]: " << frames[i] << "\n";
+void MemoryManager::printProcessSMI() {
+    // Built up under the locks and printed after, so a slow terminal never stalls a page fault
+    std::ostringstream out;
+    std::shared_lock<std::shared_mutex> registryLock(registryMutex);
+
+    out << "\n========== process-smi ==========\n";
+    {
+        std::lock_guard<std::mutex> frameLock(frameMutex);
+        out << "Total Memory: " << totalMemory << " bytes (" << frameCount << " frames)\n";
+        out << "Used Frames : " << usedFrames << "\n";
+        out << "Free Frames : " << (frameCount - usedFrames) << "\n";
+
+        out << "\nFrame Table:\n";
+        for (int i = 0; i < frameCount; ++i) {
+            out << "  Frame[" << std::setw(2) << i << "]: ";
+            if (frames[i] == FREE_FRAME) {
+                out << "EMPTY\n";
+            } else {
+                out << processesByPid.at(framePid(frames[i]))->processName << "@" << framePage(frames[i]) << "\n";
+            }
+        }
     }
 
-    std::cout << "\nProcess List:\n";
-    for (const auto& [name, proc] : processes) {
-        std::cout << "  " << name << ": " << proc.allocatedBytes << " bytes, " << proc.pageCount << " pages\n";
+    out << "\nVirtual Address Space:\n";
+    out << "  Reserved  : " << addressSpace.getReservedBytes() << " bytes\n";
+    out << "  Allocated : " << addressSpace.getAllocatedBytes() << " bytes\n";
+    out << "  Free      : " << addressSpace.getFreeBytes() << " bytes in " << addressSpace.getFreeBlockCount()
+        << " block(s), largest " << addressSpace.getLargestFreeBlock() << " bytes\n";
+    out << "  Fragmentation: " << std::fixed << std::setprecision(2) << addressSpace.getFragmentation() * 100 << "%\n";
+
+    out << "\nProcess List:\n";
+    for (auto& [name, proc] : processes) {
+        size_t touched;
+        {
+            std::lock_guard<std::mutex> procLock(proc.lock);
+            touched = proc.pageTable.size();
+        }
+        out << "  " << name << " (pid " << proc.pid << "): " << proc.allocatedBytes << " bytes at 0x" << std::hex << proc.baseAddr << std::dec << ", " << proc.pageCount << " pages ("
+            << touched << " touched), " << proc.counters.faults << " faults, " << proc.counters.pageIns << " paged in, "
+            << proc.counters.pageOuts << " paged out\n";
     }
 
-    std::cout << "=================================\n";
+    out << "=================================\n";
+    registryLock.unlock();
+    std::cout << out.str();
 }
 
-void MemoryManager::printVMStat() {
-    std::cout << "\n========== vmstat ==========\n";
-    std::cout << "Total Frames: " << frameCount << "\n";
-    std::cout << "Free Frames : " << std::count(frames.begin(), frames.end(), "EMPTY") << "\n";
-    std::cout << "Used Frames : " << frameCount - std::count(frames.begin(), frames.end(), "EMPTY") << "\n";
+void MemoryManager::printVMStat(uint64_t activeTicks, uint64_t idleTicks) {
+    std::ostringstream out;
+    std::shared_lock<std::shared_mutex> registryLock(registryMutex);
+
+    out << "\n========== vmstat ==========\n";
+    {
+        std::lock_guard<std::mutex> frameLock(frameMutex);
+        out << "Total Frames: " << frameCount << "\n";
+        out << "Free Frames : " << (frameCount - usedFrames) << "\n";
+        out << "Used Frames : " << usedFrames << "\n";
+    }
+    out << "Swap Slots  : " << backingStore.getUsedSlots() << " used / " << backingStore.getSlotCount() << " allocated\n";
+    out << "Page Faults : " << totals.faults << "\n";
+    out << "Paged In    : " << totals.pageIns << "\n";
+    out << "Paged Out   : " << totals.pageOuts << "\n";
+    out << "Dirty Writes: " << totals.dirtyWriteBacks << "\n";
+    out << "Zero Maps   : " << totals.zeroPageMaps << "\n";
+    out << "Active Ticks: " << activeTicks << "\n";
+    out << "Idle Ticks  : " << idleTicks << "\n";
+    out << "Total Ticks : " << (activeTicks + idleTicks) << "\n";
+
+    {
+        std::lock_guard<std::mutex> frameLock(frameMutex);
+        uint64_t activeReferences = referenceTime() - activeSince;
+        out << "\nPage Replacement (active: " << replacement->name() << "):\n";
+        for (const auto& [policyName, stats] : replacementStats) {
+            uint64_t references = stats.references + (&stats == activeStats ? activeReferences : 0);
+            if (references == 0 && &stats != activeStats) continue;
+            double faultRate = references ? 100.0 * stats.faults / references : 0.0;
+            out << "  " << policyName << ": " << references << " refs, " << stats.faults << " faults ("
+                << std::fixed << std::setprecision(2) << faultRate << "%), " << stats.evictions << " evictions\n";
+        }
+    }
 
-    std::cout << "\nActive Processes:\n";
-    for (const auto& [name, proc] : processes) {
-        std::cout << "  " << name << " (" << proc.pageCount << " pages):\n";
-        for (int i = 0; i < proc.pageTable.size(); ++i) {
-            std::cout << "    Page[" << i << "] -> ";
-            if (proc.pageTable[i].inMemory)
-                std::cout << "Frame " << proc.pageTable[i].frameIndex;
+    uint64_t tlbHits = 0, tlbMisses = 0;
+    out << "\nTLB (" << SoftwareTLB::ENTRIES << " entries per core):\n";
+    for (size_t i = 0; i < cores.size(); ++i) {
+        const SoftwareTLB& tlb = cores[i]->tlb;
+        tlbHits += tlb.getHits();
+        tlbMisses += tlb.getMisses();
+        out << "  Core " << i << ": " << tlb.getHits() << " hits, " << tlb.getMisses() << " misses\n";
+    }
+    double hitRate = (tlbHits + tlbMisses) ? 100.0 * tlbHits / (tlbHits + tlbMisses) : 0.0;
+    out << "  Hit ratio: " << std::fixed << std::setprecision(2) << hitRate << "%, "
+        << tlbShootdowns << " shootdowns\n";
+
+    out << "\nActive Processes:\n";
+    for (auto& [name, proc] : processes) {
+        std::lock_guard<std::mutex> procLock(proc.lock);
+        out << "  " << name << " (" << proc.pageCount << " pages):\n";
+        for (int i = 0; i < proc.pageCount; ++i) {
+            auto page = proc.pageTable.find(i);
+            if (page == proc.pageTable.end()) continue;  // Untouched
+            out << "    Page[" << i << "] -> ";
+            if (page->second.inMemory)
+                out << "Frame " << page->second.frameIndex;
             else
-                std::cout << "NOT IN MEMORY";
-            std::cout << "\n";
+                out << "NOT IN MEMORY";
+            out << "\n";
         }
     }
 
-    std::cout << "============================\n";
+    out << "============================\n";
+    registryLock.unlock();
+    std::cout << out.str();
+}
+
+void MemoryManager::writeCounters(std::ostream& out) const {
+    std::ostringstream buffer;
+    std::shared_lock<std::shared_mutex> registryLock(registryMutex);
+
+    buffer << "mem.total_bytes " << totalMemory << "\n";
+    {
+        std::lock_guard<std::mutex> frameLock(frameMutex);
+        buffer << "mem.frames_total " << frameCount << "\n";
+        buffer << "mem.frames_used " << usedFrames << "\n";
+        buffer << "mem.frames_free " << (frameCount - usedFrames) << "\n";
+    }
+    buffer << "mem.swap_slots_used " << backingStore.getUsedSlots() << "\n";
+    buffer << "mem.references " << referenceTime() << "\n";
+    buffer << "mem.faults " << totals.faults << "\n";
+    buffer << "mem.page_ins " << totals.pageIns << "\n";
+    buffer << "mem.page_outs " << totals.pageOuts << "\n";
+    buffer << "mem.dirty_writebacks " << totals.dirtyWriteBacks << "\n";
+    buffer << "mem.zero_page_maps " << totals.zeroPageMaps << "\n";
+    {
+        std::lock_guard<std::mutex> frameLock(frameMutex);
+        buffer << "mem.replacement " << replacement->name() << "\n";
+    }
+    buffer << "vas.reserved_bytes " << addressSpace.getReservedBytes() << "\n";
+    buffer << "vas.allocated_bytes " << addressSpace.getAllocatedBytes() << "\n";
+    buffer << "vas.free_blocks " << addressSpace.getFreeBlockCount() << "\n";
+    buffer << "vas.largest_free_block " << addressSpace.getLargestFreeBlock() << "\n";
+
+    uint64_t tlbHits = 0, tlbMisses = 0;
+    for (const auto& cpu : cores) {
+        tlbHits += cpu->tlb.getHits();
+        tlbMisses += cpu->tlb.getMisses();
+    }
+    buffer << "tlb.hits " << tlbHits << "\n";
+    buffer << "tlb.misses " << tlbMisses << "\n";
+    buffer << "tlb.shootdowns " << tlbShootdowns << "\n";
+
+    for (auto& [name, proc] : processes) {
+        size_t touched;
+        {
+            std::lock_guard<std::mutex> procLock(proc.lock);
+            touched = proc.pageTable.size();
+        }
+        buffer << "proc." << name << ".faults " << proc.counters.faults << "\n";
+        buffer << "proc." << name << ".page_ins " << proc.counters.pageIns << "\n";
+        buffer << "proc." << name << ".page_outs " << proc.counters.pageOuts << "\n";
+        buffer << "proc." << name << ".dirty_writebacks " << proc.counters.dirtyWriteBacks << "\n";
+        buffer << "proc." << name << ".pages_touched " << touched << "\n";
+    }
+
+    registryLock.unlock();
+    out << buffer.str();
 }
 
 bool MemoryManager::isValidAccess(const std::string& processName, int pageNumber) const {
+    std::shared_lock<std::shared_mutex> registryLock(registryMutex);
     auto it = processes.find(processName);
     if (it == processes.end()) return false;
 
     const auto& proc = it->second;
     return (pageNumber >= 0 && pageNumber < proc.pageCount);
 }
+
+bool MemoryManager::getProcessRange(const std::string& processName, int& baseAddr, int& bytes) const {
+    std::shared_lock<std::shared_mutex> registryLock(registryMutex);
+    auto it = processes.find(processName);
+    if (it == processes.end()) return false;
+
+    baseAddr = it->second.baseAddr;
+    bytes = it->second.allocatedBytes;
+    return true;
+}
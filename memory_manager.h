@@ -1,19 +1,50 @@
 #ifndef MEMORY_MANAGER_H
 #define MEMORY_MANAGER_H
 
+#include "backing_store.h"
+#include "buddy_allocator.h"
+#include "page_replacement.h"
+#include "tlb.h"
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
 #include <unordered_map>
 #include <vector>
 #include <string>
-#include <fstream>
 #include <cstdint>
 
+// Safe to call from every core at once. Locks are always taken in this order:
+//   registryMutex (shared for paging, exclusive to add/remove processes)
+//   -> one ProcessMemory::lock (guards that process's page table)
+//   -> frameMutex (frame table, free frames, replacement policy)
+// While holding frameMutex, another process's lock is only ever try-locked, to evict its page.
+// TLB hits take no lock at all.
 class MemoryManager {
 public:
     struct Page {
         int frameIndex = -1;     // Where it is in physical memory
         bool inMemory = false;   // Is it loaded?
-        bool dirty = false;      // If written, mark as dirty (for backing store writes)
-        std::vector<uint8_t> data; // Page data (simulate contents)
+        std::atomic<bool> dirty{false};  // Written since it was loaded, so eviction must write it back (set on TLB hits)
+        int swapSlot = -1;       // Backing store slot holding this page's last evicted contents
+    };
+
+    // Maintained as paging happens, so reading them is O(1)
+    struct PagingCounters {
+        std::atomic<uint64_t> faults{0};
+        std::atomic<uint64_t> pageIns{0};          // Pages loaded into a frame
+        std::atomic<uint64_t> pageOuts{0};         // Pages evicted from a frame
+        std::atomic<uint64_t> dirtyWriteBacks{0};  // Evictions that had to write a modified page back
+        std::atomic<uint64_t> zeroPageMaps{0};     // Reads of never-written pages served by the shared zero page
+    };
+
+    // A process's final counts, handed back when its memory is freed
+    struct PagingSummary {
+        uint64_t faults = 0;
+        uint64_t pageIns = 0;
+        uint64_t pageOuts = 0;
     };
 
     struct ProcessMemory {
@@ -22,45 +53,124 @@ public:
         int allocatedBytes;
         int pageCount;
         int baseAddr;
-        std::vector<Page> pageTable;
+        std::unordered_map<int, Page> pageTable;  // Only pages that were fetched or written; the rest read as zero
+        PagingCounters counters;
+        mutable std::mutex lock;                  // Guards pageTable
     };
 
     MemoryManager(int totalMemoryBytes = 4096, int pageSize = 256); // Default 4KB RAM
 
     int allocateProcess(const std::string& processName, int memoryBytes);
-    void deallocateProcess(const std::string& processName);
+    void deallocateProcess(const std::string& processName, PagingSummary* summary = nullptr);
 
-    void accessPage(const std::string& processName, int pageNumber);
+    void setCoreCount(int cores);   // One TLB per core; only valid while the scheduler is stopped
+    void accessPage(int core, int pid, int pageNumber);  // Goes through the core's TLB first
+
+    // Emulated memory, addressed from 0 within the process. Return false on an access violation.
+    bool readWord(int core, int pid, uint32_t address, uint16_t& value);
+    bool writeWord(int core, int pid, uint32_t address, uint16_t value);
     void printProcessSMI();
-    void printVMStat();
+    void printVMStat(uint64_t activeTicks, uint64_t idleTicks);  // CPU ticks come from the scheduler
+    void writeCounters(std::ostream& out) const;  // "name value" lines for vmstat --raw
     bool isValidAccess(const std::string& processName, int pageNumber) const;
+    bool getProcessRange(const std::string& processName, int& baseAddr, int& bytes) const;  // False if it has no memory
     int getPageSize() const { return pageSize; }
 
-    void initializeBackingStore();  // Clear backing store file
-    
-    const std::unordered_map<std::string, ProcessMemory>& getProcesses() const {
-        return processes;
-    }
+    void initializeBackingStore();  // Recreate an empty backing store file
+    void setReplacementPolicy(std::unique_ptr<ReplacementPolicy> policy); // Keeps resident pages
 
 private:
     int totalMemory;
     int pageSize;
     int frameCount;
 
-    std::vector<std::string> frames; // Holds processName@pageIndex in physical memory
+    // Each frame holds a packed (pid << 32 | page) entry, or FREE_FRAME
+    static constexpr uint64_t FREE_FRAME = UINT64_MAX;
+    static uint64_t packFrame(int pid, int page) { return (static_cast<uint64_t>(pid) << 32) | static_cast<uint32_t>(page); }
+    static int framePid(uint64_t entry) { return static_cast<int>(entry >> 32); }
+    static int framePage(uint64_t entry) { return static_cast<int>(entry & 0xFFFFFFFFu); }
+
+    std::vector<uint64_t> frames;
+    std::vector<Page*> framePages;   // Resident page of each frame, for marking it dirty after a TLB hit
+    std::vector<uint8_t> physicalMemory;  // frameCount * pageSize bytes; frame i starts at i * pageSize
+
+    // Read-only page of zeros that reads of untouched pages are mapped to, instead of a frame
+    static constexpr int ZERO_FRAME = 0xFFFF;  // Fits the TLB's frame field; real frames stay below it
+    std::vector<uint8_t> zeroPage;
+
+    uint8_t* frameData(int frameIndex) {
+        if (frameIndex == ZERO_FRAME) return zeroPage.data();
+        return physicalMemory.data() + static_cast<size_t>(frameIndex) * pageSize;
+    }
+    std::vector<int> freeFrames;     // Stack of free frame indices
+    int usedFrames = 0;
+    PagingCounters totals;           // Includes processes that have since been deallocated
+
     std::unordered_map<std::string, ProcessMemory> processes;
+    std::unordered_map<int, ProcessMemory*> processesByPid; // Points into processes (node-based, so stable)
+    int nextPid = 1;                 // Never reused, so stale frame entries cannot alias a new process
+
+    BackingStore backingStore;
+    BuddyAllocator addressSpace;     // Hands out each process's [baseAddr, baseAddr + allocatedBytes)
 
-    std::ofstream backingStore;
+    mutable std::shared_mutex registryMutex;  // processes, processesByPid, nextPid, addressSpace
+    mutable std::mutex frameMutex;            // frames, framePages, freeFrames, usedFrames, replacement*
 
-    void pageIn(const std::string& processName, int pageNumber);
-    void pageOut(int frameIndex);
+    // Instruction fetches and writes need a private frame; reads of an untouched page can share the zero page
+    enum class Access { FETCH, READ, WRITE };
 
-    int findFreeFrame();
-    int replacePage(); // FIFO for now
+    // Copies count bytes at address to or from data, which must not cross a page. False if invalid.
+    bool access(int core, int pid, uint32_t address, Access kind, uint8_t* data, int count);
+
+    // One core's translation state. TLB hits are queued here and replayed into the
+    // replacement policy under frameMutex, so that a hit never waits for a lock.
+    // References are counted per core too, and only added up into the policies' time on replay.
+    struct AccessHint {
+        int frame;
+        uint64_t entry;     // Frame contents at the time, to skip hints for frames reassigned since
+        uint64_t time;      // The core's own reference count at the time
+    };
+    struct CoreMemory {
+        static const size_t HINT_CAPACITY = 256;  // Power of two
+        SoftwareTLB tlb;
+        AccessHint hints[HINT_CAPACITY];
+        alignas(64) std::atomic<size_t> hintHead{0};  // Advanced by whoever holds frameMutex
+        alignas(64) std::atomic<size_t> hintTail{0};  // Advanced by the owning core
+        std::atomic<uint64_t> references{0};          // Written only by the owning core
+        uint64_t replayedReferences = 0;              // Part of references already in the policies' time; needs frameMutex
+    };
+    std::vector<std::unique_ptr<CoreMemory>> cores;
+
+    bool accessSlow(CoreMemory& cpu, int pid, int pageNumber, int offset, Access kind, uint8_t* data, int count);
+    void copyBytes(int frameIndex, int offset, Access kind, uint8_t* data, int count);
+    void recordHint(CoreMemory& cpu, int frameIndex, uint64_t entry, uint64_t time);
+    void drainHints();               // Needs frameMutex
+    uint64_t countReference(CoreMemory& cpu);  // Returns the core's own count, for its hint
+    uint64_t referenceTime() const;  // Page references so far, summed over the cores
+
+    void pageIn(ProcessMemory& proc, int pageNumber, Page& page, uint64_t now);  // Needs proc.lock
+    int claimFrame(ProcessMemory& proc, int pageNumber, Page& page, uint64_t now);
+    void releaseFrame(int frameIndex);  // Needs frameMutex
+    void shootdown(int pid, int pageNumber);  // Drop the translation from every core's TLB and wait out hits in flight
+
+    void writePageToBackingStore(const std::string& processName, int pageNumber, Page& page, int frameIndex);
+    void readPageFromBackingStore(const std::string& processName, int pageNumber, Page& page, int frameIndex);
+
+    // Paging behaviour under each policy used this session, so they can be compared
+    struct ReplacementStats {
+        uint64_t references = 0;
+        uint64_t faults = 0;
+        uint64_t evictions = 0;
+    };
 
-    void writePageToBackingStore(const std::string& processName, int pageNumber, const std::vector<uint8_t>& pageData);
+    std::unique_ptr<ReplacementPolicy> replacement;
+    std::map<std::string, ReplacementStats> replacementStats;
+    ReplacementStats* activeStats = nullptr;
+    uint64_t activeSince = 0;        // referenceTime() when the active policy took over
+    uint64_t policyTime = 0;         // References replayed so far; the policies' notion of time. Needs frameMutex
+    std::atomic<uint64_t> retiredReferences{0};  // Counted by cores since dropped by setCoreCount
 
-    std::vector<std::string> pageHistory; // FIFO replacement
+    std::atomic<uint64_t> tlbShootdowns{0};
 };
 
 extern MemoryManager memManager;
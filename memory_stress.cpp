@@ -0,0 +1,118 @@
+// Stress test for MemoryManager: every thread acts as one core, allocating
+// processes, reading and writing their memory while the other cores evict
+// its pages, and deallocating them again. Each thread keeps a shadow copy
+// of what it wrote, so a lost write-back or a stale translation shows up as
+// a mismatch. Run once per replacement policy.
+//
+// Usage: memory_stress [threads] [rounds]   (threads defaults to num-cpu in config.txt)
+#include "memory_manager.h"
+#include "page_replacement.h"
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static int configuredCpus() {
+    std::ifstream file("config.txt");
+    std::string key;
+    int value;
+    while (file >> key) {
+        if (key == "num-cpu" && file >> value) return value;
+        file.ignore(1024, '\n');
+    }
+    return 4;
+}
+
+static uint64_t counterValue(const std::string& name) {
+    std::ostringstream out;
+    memManager.writeCounters(out);
+    std::istringstream in(out.str());
+    std::string key;
+    uint64_t value;
+    while (in >> key >> value) {
+        if (key == name) return value;
+    }
+    return 0;
+}
+
+// One core's workload; returns the number of mismatched or failed accesses
+static int runCore(int core, int rounds, const std::string& policy) {
+    std::mt19937 rng(core * 7919 + 1);
+    int errors = 0;
+
+    for (int round = 0; round < rounds; ++round) {
+        std::string name = policy + "_c" + std::to_string(core) + "_r" + std::to_string(round);
+        int bytes = 1024 << (rng() % 4);    // 4 to 32 pages against 16 frames, so cores evict each other
+        int pid = memManager.allocateProcess(name, bytes);
+        if (pid == -1) {
+            std::cout << "[ERROR] Could not allocate " << name << "\n";
+            errors++;
+            continue;
+        }
+
+        std::vector<uint8_t> shadow(bytes, 0);  // Fresh pages read as zero
+        for (int i = 0; i < 4000; ++i) {
+            uint32_t address = rng() % (bytes - 1);
+            if (rng() % 2) {
+                uint16_t value = static_cast<uint16_t>(rng());
+                if (!memManager.writeWord(core, pid, address, value)) errors++;
+                shadow[address] = value & 0xFF;
+                shadow[address + 1] = value >> 8;
+            } else {
+                uint16_t value = 0;
+                if (!memManager.readWord(core, pid, address, value)) errors++;
+                uint16_t expected = static_cast<uint16_t>(shadow[address] | (shadow[address + 1] << 8));
+                if (value != expected) errors++;
+            }
+            if (i % 64 == 0) memManager.accessPage(core, pid, static_cast<int>(rng() % (bytes / memManager.getPageSize())));
+        }
+
+        // Out-of-range accesses must be refused, not wrap into another process
+        uint16_t ignored;
+        if (memManager.readWord(core, pid, bytes, ignored)) errors++;
+
+        memManager.deallocateProcess(name);
+        if (memManager.getProcessRange(name, pid, bytes)) errors++;
+    }
+    return errors;
+}
+
+int main(int argc, char* argv[]) {
+    int threads = argc > 1 ? std::atoi(argv[1]) : configuredCpus();
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 20;
+    if (threads < 1 || rounds < 1) {
+        std::cout << "Usage: memory_stress [threads] [rounds]\n";
+        return 2;
+    }
+
+    int failures = 0;
+    for (const char* policy : {"fifo", "lru", "second-chance", "clock", "working-set"}) {
+        SystemConfig config;
+        config.pageReplacement = policy;
+        memManager.setCoreCount(threads);
+        memManager.setReplacementPolicy(makeReplacementPolicy(config));
+
+        std::atomic<int> errors{0};
+        std::vector<std::thread> cores;
+        for (int core = 0; core < threads; ++core) {
+            cores.emplace_back([&, core] { errors += runCore(core, rounds, policy); });
+        }
+        for (auto& core : cores) core.join();
+
+        // Everything was deallocated, so no frame or swap slot may still be held
+        uint64_t framesUsed = counterValue("mem.frames_used");
+        uint64_t swapUsed = counterValue("mem.swap_slots_used");
+        bool passed = errors == 0 && framesUsed == 0 && swapUsed == 0;
+        if (!passed) failures++;
+
+        std::cout << (passed ? "[PASS] " : "[FAIL] ") << policy << ": " << threads << " cores, " << rounds
+                  << " rounds, " << errors << " errors, " << framesUsed << " frames and " << swapUsed
+                  << " swap slots still used, " << counterValue("mem.page_outs") << " page-outs so far\n";
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,155 @@
+#include "page_replacement.h"
+
+std::unique_ptr<ReplacementPolicy> makeReplacementPolicy(const SystemConfig& config) {
+    const std::string& name = config.pageReplacement;
+    if (name == "lru") return std::make_unique<LRUReplacement>();
+    if (name == "second-chance") return std::make_unique<SecondChanceReplacement>();
+    if (name == "clock") return std::make_unique<ClockReplacement>();
+    if (name == "working-set") return std::make_unique<WorkingSetReplacement>(config.workingSetWindow);
+    return std::make_unique<FIFOReplacement>();
+}
+
+void FrameList::reset(int frameCount) {
+    prev.assign(frameCount, -1);
+    next.assign(frameCount, -1);
+    head = tail = -1;
+}
+
+void FrameList::pushBack(int frame) {
+    prev[frame] = tail;
+    next[frame] = -1;
+    if (tail != -1) next[tail] = frame;
+    else head = frame;
+    tail = frame;
+}
+
+void FrameList::pushFront(int frame) {
+    prev[frame] = -1;
+    next[frame] = head;
+    if (head != -1) prev[head] = frame;
+    else tail = frame;
+    head = frame;
+}
+
+void FrameList::remove(int frame) {
+    int p = prev[frame];
+    int n = next[frame];
+    if (p != -1) next[p] = n;
+    else if (head == frame) head = n;
+    else return;  // Not linked
+    if (n != -1) prev[n] = p;
+    else tail = p;
+    prev[frame] = next[frame] = -1;
+}
+
+int FIFOReplacement::selectVictim(uint64_t) {
+    int victim = order.front();
+    if (victim != -1) order.remove(victim);
+    return victim;
+}
+
+void LRUReplacement::onAccess(int frame, uint64_t) {
+    // Move to the most-recently-used end
+    order.remove(frame);
+    order.pushBack(frame);
+}
+
+int LRUReplacement::selectVictim(uint64_t) {
+    int victim = order.front();
+    if (victim != -1) order.remove(victim);
+    return victim;
+}
+
+void SecondChanceReplacement::reset(int frameCount) {
+    order.reset(frameCount);
+    referenced.assign(frameCount, 0);
+}
+
+void SecondChanceReplacement::onLoad(int frame, uint64_t) {
+    referenced[frame] = 1;
+    order.pushBack(frame);
+}
+
+int SecondChanceReplacement::selectVictim(uint64_t) {
+    // Every requeue clears a bit, so this ends within one pass over the queue
+    while (order.front() != -1) {
+        int frame = order.front();
+        order.remove(frame);
+        if (!referenced[frame]) return frame;
+        referenced[frame] = 0;
+        order.pushBack(frame);
+    }
+    return -1;
+}
+
+void ClockReplacement::reset(int frameCount) {
+    referenced.assign(frameCount, 0);
+    occupied.assign(frameCount, 0);
+    hand = 0;
+}
+
+void ClockReplacement::onLoad(int frame, uint64_t) {
+    occupied[frame] = 1;
+    referenced[frame] = 1;
+}
+
+int ClockReplacement::selectVictim(uint64_t) {
+    int frameCount = static_cast<int>(occupied.size());
+    // Two sweeps: the first may only clear reference bits
+    for (int step = 0; step < 2 * frameCount; ++step) {
+        int frame = hand;
+        hand = (hand + 1) % frameCount;
+        if (!occupied[frame]) continue;
+        if (referenced[frame]) {
+            referenced[frame] = 0;
+            continue;
+        }
+        occupied[frame] = 0;
+        return frame;
+    }
+    return -1;
+}
+
+void WorkingSetReplacement::reset(int frameCount) {
+    lastUse.assign(frameCount, 0);
+    referenced.assign(frameCount, 0);
+    occupied.assign(frameCount, 0);
+    hand = 0;
+}
+
+void WorkingSetReplacement::onLoad(int frame, uint64_t now) {
+    occupied[frame] = 1;
+    referenced[frame] = 0;
+    lastUse[frame] = now;
+}
+
+void WorkingSetReplacement::onAccess(int frame, uint64_t now) {
+    referenced[frame] = 1;
+    lastUse[frame] = now;
+}
+
+int WorkingSetReplacement::selectVictim(uint64_t now) {
+    int frameCount = static_cast<int>(occupied.size());
+    int oldest = -1;
+
+    for (int step = 0; step < 2 * frameCount; ++step) {
+        int frame = hand;
+        hand = (hand + 1) % frameCount;
+        if (!occupied[frame]) continue;
+
+        if (referenced[frame]) {
+            referenced[frame] = 0;
+            continue;
+        }
+        // Hits are replayed in batches, so a page may have been used after "now"
+        if (now > lastUse[frame] && now - lastUse[frame] > window) {
+            occupied[frame] = 0;
+            return frame;
+        }
+        if (oldest == -1 || lastUse[frame] < lastUse[oldest]) oldest = frame;
+    }
+
+    // Every resident page is in some working set: evict the least recently used one
+    if (oldest != -1) occupied[oldest] = 0;
+    return oldest;
+}
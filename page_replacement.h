@@ -0,0 +1,127 @@
+#ifndef PAGE_REPLACEMENT_H
+#define PAGE_REPLACEMENT_H
+
+#include "config.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Header file for page_replacement.cpp
+// Chooses which resident frame to evict when memory is full. MemoryManager
+// reports every load, reference and release; times are its reference count.
+class ReplacementPolicy {
+public:
+    virtual ~ReplacementPolicy() = default;
+    virtual const char* name() const = 0;
+
+    virtual void reset(int frameCount) = 0;
+    virtual void onLoad(int frame, uint64_t now) = 0;      // A page was placed in the frame
+    virtual void onAccess(int frame, uint64_t now) = 0;    // A resident page was referenced
+    virtual void onRelease(int frame) = 0;                 // The frame was freed without eviction
+    virtual int selectVictim(uint64_t now) = 0;            // Forgets and returns the frame to evict
+    virtual void requeue(int frame) = 0;                   // A selected victim stays resident, with its recency as it was
+};
+
+// Doubly linked list of frame indices, so queue moves and unlinks are O(1)
+class FrameList {
+public:
+    void reset(int frameCount);
+    void pushBack(int frame);
+    void pushFront(int frame);
+    void remove(int frame);
+    int front() const { return head; }
+
+private:
+    std::vector<int> prev;
+    std::vector<int> next;
+    int head = -1;
+    int tail = -1;
+};
+
+// Evicts the page that was loaded first
+class FIFOReplacement : public ReplacementPolicy {
+public:
+    const char* name() const override { return "fifo"; }
+    void reset(int frameCount) override { order.reset(frameCount); }
+    void onLoad(int frame, uint64_t) override { order.pushBack(frame); }
+    void onAccess(int, uint64_t) override {}
+    void onRelease(int frame) override { order.remove(frame); }
+    int selectVictim(uint64_t now) override;
+    void requeue(int frame) override { order.pushFront(frame); }
+
+private:
+    FrameList order;
+};
+
+// Evicts the page referenced least recently
+class LRUReplacement : public ReplacementPolicy {
+public:
+    const char* name() const override { return "lru"; }
+    void reset(int frameCount) override { order.reset(frameCount); }
+    void onLoad(int frame, uint64_t) override { order.pushBack(frame); }
+    void onAccess(int frame, uint64_t now) override;
+    void onRelease(int frame) override { order.remove(frame); }
+    int selectVictim(uint64_t now) override;
+    void requeue(int frame) override { order.pushFront(frame); }
+
+private:
+    FrameList order;
+};
+
+// FIFO, but a page whose reference bit is set goes back to the tail once
+class SecondChanceReplacement : public ReplacementPolicy {
+public:
+    const char* name() const override { return "second-chance"; }
+    void reset(int frameCount) override;
+    void onLoad(int frame, uint64_t) override;
+    void onAccess(int frame, uint64_t) override { referenced[frame] = 1; }
+    void onRelease(int frame) override { order.remove(frame); }
+    int selectVictim(uint64_t now) override;
+    void requeue(int frame) override { order.pushFront(frame); }
+
+private:
+    FrameList order;
+    std::vector<uint8_t> referenced;
+};
+
+// A hand sweeps the frames in order, clearing reference bits until it finds a clear one
+class ClockReplacement : public ReplacementPolicy {
+public:
+    const char* name() const override { return "clock"; }
+    void reset(int frameCount) override;
+    void onLoad(int frame, uint64_t) override;
+    void onAccess(int frame, uint64_t) override { referenced[frame] = 1; }
+    void onRelease(int frame) override { occupied[frame] = 0; }
+    int selectVictim(uint64_t now) override;
+    void requeue(int frame) override { occupied[frame] = 1; }
+
+private:
+    std::vector<uint8_t> referenced;
+    std::vector<uint8_t> occupied;
+    int hand = 0;
+};
+
+// WSClock: like CLOCK, but only evicts a page outside the working set, i.e. one
+// not referenced within the last `window` references. Falls back to the oldest.
+class WorkingSetReplacement : public ReplacementPolicy {
+public:
+    explicit WorkingSetReplacement(uint32_t windowRefs) : window(windowRefs > 0 ? windowRefs : 1) {}
+    const char* name() const override { return "working-set"; }
+    void reset(int frameCount) override;
+    void onLoad(int frame, uint64_t now) override;
+    void onAccess(int frame, uint64_t now) override;
+    void onRelease(int frame) override { occupied[frame] = 0; }
+    int selectVictim(uint64_t now) override;
+    void requeue(int frame) override { occupied[frame] = 1; }
+
+private:
+    uint64_t window;
+    std::vector<uint64_t> lastUse;
+    std::vector<uint8_t> referenced;
+    std::vector<uint8_t> occupied;
+    int hand = 0;
+};
+
+std::unique_ptr<ReplacementPolicy> makeReplacementPolicy(const SystemConfig& config);
+
+#endif
@@ -1,316 +1,241 @@
 #include "process.h"
-#include "variable_manager.h"
 #include "memory_manager.h"
+#include "process_logger.h"
+#include "process_pool.h"
 #include <ctime>
 #include <iomanip>
 #include <sstream>
 #include <mutex>
 #include <iostream>
-#include <regex>
 
-extern std::mutex processMutex;
-
-// FOR loop helper structure
-struct Loop {
-    std::string body;
-    int repeats;
-};
-
-// Helper: split instructions by "@@" delimiter
-std::vector<std::string> splitInstructions(const std::string& body) {
-    std::vector<std::string> result;
-    size_t start = 0, end;
-    while ((end = body.find("@@", start)) != std::string::npos) {
-        result.push_back(body.substr(start, end - start));
-        start = end + 2;
-    }
-    result.push_back(body.substr(start));
-    return result;
+Process::Process(std::string n, int total, const std::vector<std::string>& instrs)
+    : name(n), currentLine(0), totalLines(total), coreAssigned(-1), isFinished(false) {
+    compileProgram(instrs, program);
+    symbolTable.reset(program.symbols.size());
+    createdAt = time(nullptr);
+    timestamp = formatTimestamp(createdAt);
 }
 
-// Fixed nested FOR extractor with bracket tracking
-std::vector<Loop> extractNestedLoops(const std::string& cmd, const std::string& processName) {
-    std::vector<Loop> loops;
-    std::string current = cmd;
+#include "process.h"
 
-    // std::cout << "[DEBUG] Parsing FOR loop for process: " << processName << "\n";
+Process::Process(std::string n, int total)
+    : name(n), totalLines(total), currentLine(0), isFinished(false), createdAt(time(nullptr)) {}
 
-    for (int depth = 0; depth < 4; ++depth) {
-        std::smatch match;
-        std::regex pattern(R"(FOR\(\[(.*)\],\s*(\d+)\))");
-        if (!std::regex_match(current, match, pattern)) break;
 
-        std::string body = match[1].str();
-        int repeat = std::stoi(match[2].str());
+Process::~Process() {}
 
-        // std::cout << "[DEBUG] Matched FOR at depth " << depth << " with repeat = " << repeat << "\n";
+void Process::setInstructions(const std::vector<std::string>& instrs) {
+    releaseExecutionState();
+    compileProgram(instrs, program);
+    symbolTable.reset(program.symbols.size());
+    instructionPointer = 0;
+}
 
-        // Bracket balancing to find deepest nested FOR
-        int forStart = body.find("FOR([");
-        int openBrackets = 0;
-        int nestedStart = -1;
-        int nestedEnd = -1;
+void Process::releaseExecutionState() {
+    // The stacks and symbol slots live in the arena too, so they have to let go of it before it is released
+    forStartPointers = LoopStack(&program.arena);
+    forLoopCounters = LoopStack(&program.arena);
+    symbolTable = VariableManager(&program.arena);
+    program.clear();
+}
 
-        for (size_t i = 0; i < body.size(); ++i) {
-            if (body.substr(i, 5) == "FOR([") {
-                if (openBrackets == 0) nestedStart = i;
-                openBrackets++;
-                i += 4;
-            } else if (body[i] == ']') {
-                openBrackets--;
-                if (openBrackets == 0 && nestedStart != -1) {
-                    // look forward for ')'
-                    size_t closeParen = body.find(')', i);
-                    if (closeParen != std::string::npos) {
-                        nestedEnd = closeParen;
-                        break;
-                    }
-                }
-            }
-        }
+void* Process::operator new(size_t bytes) {
+    return processPool.allocate(bytes);
+}
 
-        if (nestedStart != -1 && nestedEnd != -1) {
-            std::string outer = body.substr(0, nestedStart - 4); // Remove trailing "@@"
-            std::string nested = body.substr(nestedStart, nestedEnd - nestedStart + 1);
+void Process::operator delete(void* slot, size_t bytes) {
+    processPool.deallocate(slot, bytes);
+}
 
-            // std::cout << "[DEBUG] Level " << depth << " body (outer): " << outer << "\n";
-            loops.push_back({outer, repeat});
-            current = nested;
-        } else {
-            // std::cout << "[DEBUG] Final level body: " << body << "\n";
-            loops.push_back({body, repeat});
-            break;
-        }
+// Formats a log timestamp, reusing the previous result while the second is unchanged
+const std::string& formatTimestamp(time_t now) {
+    thread_local time_t cachedTime = -1;
+    thread_local std::string cached;
+    if (now != cachedTime) {
+        tm localTime;
+        // localtime() shares one buffer between all cores
+        #ifdef _WIN32
+        localtime_s(&localTime, &now);
+        #else
+        localtime_r(&now, &localTime);
+        #endif
+        std::stringstream ts;
+        ts << std::put_time(&localTime, "%m/%d/%Y %I:%M:%S%p");
+        cached = ts.str();
+        cachedTime = now;
     }
+    return cached;
+}
 
-    std::reverse(loops.begin(), loops.end());
-
-    // std::cout << "[DEBUG] Detected " << loops.size() << " nested FOR loop(s)\n";
-    for (int i = 0; i < loops.size(); ++i) {
-        // std::cout << "  Loop Level " << i << " - Repeats: " << loops[i].repeats << "\n";
-        for (auto& ins : splitInstructions(loops[i].body)) {
-            // std::cout << "    [L" << i << "] " << ins << "\n";
-        }
+// Hands a log line to the batched process logger; PRINT output is also kept for screen -r
+void Process::appendLog(int core, std::string entry, bool keepRecent) {
+    if (keepRecent) {
+        std::lock_guard<std::mutex> lock(logMutex);
+        logs[logCount++ % MAX_LOGS].assign(entry);
     }
-
-    return loops;
+    processLogger.log(core, name, logSequence++, std::move(entry));
 }
 
-Process::Process(std::string n, int total, const std::vector<std::string>& instrs)
-    : name(n), currentLine(0), totalLines(total), coreAssigned(-1), isFinished(false), instructions(instrs) {
-    time_t now = time(nullptr);
-    tm* localTime = localtime(&now);
-    std::stringstream ss;
-    ss << std::put_time(localTime, "%m/%d/%Y %I:%M:%S%p");
-    timestamp = ss.str();
-    logFile.open(name + "_log.txt");
-    if (!logFile.is_open()) {
-        std::cerr << "Failed to open log file for " << name << "\n";
+std::deque<std::string> Process::recentLogs() {
+    std::lock_guard<std::mutex> lock(logMutex);
+    std::deque<std::string> recent;
+    size_t first = logCount > MAX_LOGS ? logCount - MAX_LOGS : 0;
+    for (size_t i = first; i < logCount; ++i) {
+        recent.push_back(logs[i % MAX_LOGS]);
     }
+    return recent;
 }
 
-#include "process.h"
-
-Process::Process(std::string n, int total)
-    : name(n), totalLines(total), currentLine(0), isFinished(false) {}
-
+// Resolves an operand to its current value
+static int operandValue(const VariableManager& symbolTable, const Operand& operand) {
+    if (operand.kind == OperandKind::LITERAL) return operand.value;
+    if (operand.kind == OperandKind::VARIABLE) return symbolTable.get(operand.value);
+    return 0;
+}
 
-Process::~Process() {
-    if (logFile.is_open()) logFile.close();
+static std::string formatAddress(uint32_t address) {
+    std::ostringstream out;
+    out << "0x" << std::uppercase << std::hex << address;
+    return out.str();
 }
 
-void Process::executePrint(int core, int tick) {
-    std::lock_guard<std::mutex> lock(processMutex);
+// Returns the instruction to run next, first closing or repeating any loop whose body just ended.
+// Returns nullptr once the program has run to completion.
+const Instruction* Process::currentInstruction() {
+    while (!forStartPointers.empty()) {
+        int start = forStartPointers.top();
+        int end = start + static_cast<int>(program.code[start - 1].span);
+        if (instructionPointer != end) break;
 
-    if (instructionPointer >= instructions.size()) {
-        if (!forLoopCounters.empty() && forLoopCounters.top() > 1) {
+        if (forLoopCounters.top() > 1) {
             forLoopCounters.top()--;
-            instructionPointer = forStartPointers.top();
-        } else if (!forLoopCounters.empty()) {
+            instructionPointer = start;
+        } else {
             forLoopCounters.pop();
             forStartPointers.pop();
-        } else {
-            isFinished = true;
-            return;
         }
     }
 
-    std::string cmd = instructions[instructionPointer++];
-    // std::cout << "[" << name << "] Executing: " << cmd << "\n";
+    if (instructionPointer >= static_cast<int>(program.code.size())) return nullptr;
+    return &program.code[instructionPointer];
+}
+
+// Only touches this process's own state; the memory manager and logger handle concurrent cores themselves
+void Process::executePrint(int core, int tick) {
+    const Instruction* next = currentInstruction();
+    if (!next) {
+        isFinished = true;
+        return;
+    }
+
+    const Instruction& instr = *next;
     // Memory access simulation: 4 instructions per page
     int pageToAccess = currentLine / 4;
-    memManager.accessPage(name, pageToAccess);
+    memManager.accessPage(core, pid, pageToAccess);
 
+    if (instr.op == OpCode::FOR) {
+        // Enter the loop in place; the body is re-run by currentInstruction()
+        if (instr.imm == 0 || instr.span == 0) {
+            instructionPointer += 1 + instr.span;
+        } else {
+            forStartPointers.push(instructionPointer + 1);
+            forLoopCounters.push(static_cast<int>(instr.imm));
+            instructionPointer++;
+        }
+        return;
+    }
+    instructionPointer++;
 
     time_t now = time(nullptr);
-    tm* localTime = localtime(&now);
-    std::stringstream ts;
-    ts << std::put_time(localTime, "%m/%d/%Y %I:%M:%S%p");
-    std::string timestamp = ts.str();
-
-    if (cmd.rfind("SLEEP(", 0) == 0) {
-        std::smatch match;
-        std::regex pattern(R"(SLEEP\((\d+)\))");
-
-        if (std::regex_match(cmd, match, pattern)) {
-            int ticks = std::stoi(match[1]);
-            sleepFor(std::min(255, std::max(0, ticks)));
-            logFile << "(" << timestamp << ") Core:" << core
-                << " \"SLEEP(" << ticks << ") from " << name << "\"\n";
-            logFile.flush();
+    const std::string& timestamp = formatTimestamp(now);
+    std::string prefix = "(" + timestamp + ") Core:" + std::to_string(core) + " \"";
+
+    switch (instr.op) {
+        case OpCode::SLEEP: {
+            int ticks = static_cast<int>(std::min<uint32_t>(instr.imm, 255));
+            sleepFor(ticks);
+            appendLog(core, prefix + "SLEEP(" + std::to_string(instr.imm) + ") from " + name + "\"", false);
             return;
         }
-    } else if (cmd.rfind("PRINT(", 0) == 0) {
-        std::smatch match;
-        std::regex withVar(R"(PRINT\(\"([^\"]*)\"\s*\+\s*([^)]+)\))");
-        std::regex justMsg(R"(PRINT\(\"([^\"]*)\"\))");
-
-        std::string logEntry;
-
-        if (std::regex_match(cmd, match, withVar)) {
-            std::string msg = match[1];
-            std::string var = match[2];
-            int val = varManager.getValue(var);
-            logEntry = "(" + timestamp + ") Core:" + std::to_string(core) + " \"" + msg + std::to_string(val) + " from " + name + "\"";
-        } else if (std::regex_match(cmd, match, justMsg)) {
-            std::string msg = match[1];
-            logEntry = "(" + timestamp + ") Core:" + std::to_string(core) + " \"" + msg + " from " + name + "\"";
-        }
-
-        if (!logEntry.empty()) {
-            logFile << logEntry << "\n";
-            logFile.flush();
-
-            // NEW: Save to in-memory log list
-            logs.push_back(logEntry);
-            if (logs.size() > MAX_LOGS) logs.pop_front();
-        }
-    } else if (cmd.rfind("DECLARE(", 0) == 0) {
-        std::smatch match;
-        std::regex pattern(R"(DECLARE\(([^,]+),\s*([^)]+)\))");
-        if (std::regex_match(cmd, match, pattern)) {
-            std::string var = match[1];
-            int val = varManager.getValue(match[2]);
-            varManager.declare(var, VariableManager::clamp16(val));
-            logFile << "(" << timestamp << ") Core:" << core
-                << " \"DECLARE " << var << " = " << VariableManager::clamp16(val) << " from " << name << "\"\n";
-            logFile.flush();
+        case OpCode::PRINT: {
+            std::string logEntry = prefix;
+            logEntry += program.messages[instr.imm];
+            if (instr.args[0].kind != OperandKind::NONE) {
+                logEntry += std::to_string(operandValue(symbolTable, instr.args[0]));
+            }
+            logEntry += " from " + name + "\"";
+            appendLog(core, std::move(logEntry), true);
+            break;
         }
-    } else if (cmd.rfind("ADD(", 0) == 0) {
-        std::smatch match;
-        std::regex pattern(R"(ADD\(([^,]+),\s*([^,]+),\s*([^)]+)\))");
-        if (std::regex_match(cmd, match, pattern)) {
-            std::string var1 = match[1];
-            int val2 = varManager.getValue(match[2]);
-            int val3 = varManager.getValue(match[3]);
-            int result = val2 + val3;
-            varManager.declare(var1, VariableManager::clamp16(result));
-            logFile << "(" << timestamp << ") Core:" << core
-                << " \"ADD(" << var1 << ", " << val2 << ", " << val3 << ") from " << name << "\"\n";
-            logFile.flush();
+        case OpCode::DECLARE: {
+            const std::pmr::string& var = program.symbols[instr.args[0].value];
+            uint16_t val = VariableManager::clamp16(operandValue(symbolTable, instr.args[1]));
+            symbolTable.declare(instr.args[0].value, val);
+            appendLog(core, (prefix + "DECLARE ").append(var) + " = " + std::to_string(val) + " from " + name + "\"", false);
+            break;
         }
-    } else if (cmd.rfind("SUBTRACT(", 0) == 0) {
-        std::smatch match;
-        std::regex pattern(R"(SUBTRACT\(([^,]+),\s*([^,]+),\s*([^)]+)\))");
-        if (std::regex_match(cmd, match, pattern)) {
-            std::string var1 = match[1];
-            int val2 = varManager.getValue(match[2]);
-            int val3 = varManager.getValue(match[3]);
-            int result = VariableManager::clamp16(std::max(0, val2 - val3));
-            varManager.declare(var1, VariableManager::clamp16(result));
-            logFile << "(" << timestamp << ") Core:" << core
-                << " \"SUBTRACT(" << var1 << ", " << val2 << ", " << val3 << ") from " << name << "\"\n";
-            logFile.flush();
+        case OpCode::ADD:
+        case OpCode::SUBTRACT: {
+            const std::pmr::string& var1 = program.symbols[instr.args[0].value];
+            int val2 = operandValue(symbolTable, instr.args[1]);
+            int val3 = operandValue(symbolTable, instr.args[2]);
+            bool isAdd = instr.op == OpCode::ADD;
+            int result = isAdd ? val2 + val3 : std::max(0, val2 - val3);
+            symbolTable.declare(instr.args[0].value, VariableManager::clamp16(result));
+            appendLog(core, (prefix + (isAdd ? "ADD(" : "SUBTRACT(")).append(var1) + ", " + std::to_string(val2) + ", "
+                + std::to_string(val3) + ") from " + name + "\"", false);
+            break;
         }
-    } else if (cmd.rfind("FOR([", 0) == 0) {
-        // std::cout << "\n\nFOR loop structure: " << cmd << "\n\n";
-        // std::cout << "[DEBUG] Parsing FOR loop for process: " << name << "\n";
-        std::vector<Loop> loops = extractNestedLoops(cmd, name);
-        // std::cout << "[DEBUG] Detected " << loops.size() << " nested FOR loop(s)\n";
-
-        std::vector<std::string> result;
-
-        for (size_t i = 0; i < loops.size(); ++i) {
-            // std::cout << "  Loop Level " << i << " - Repeats: " << loops[i].repeats << "\n";
-            auto lines = splitInstructions(loops[i].body);
-            for (const auto& line : lines) {
-                // std::cout << "    [L" << i << "] " << line << "\n";
+        case OpCode::READ: {
+            uint16_t val = 0;
+            if (!memManager.readWord(core, pid, instr.imm, val)) {
+                raiseAccessViolation(core, instr.imm, now);
+                return;
             }
+            symbolTable.declare(instr.args[0].value, val);
+            appendLog(core, (prefix + "READ ").append(program.symbols[instr.args[0].value]) + " = " + std::to_string(val)
+                + " from " + formatAddress(instr.imm) + " in " + name + "\"", false);
+            break;
         }
-
-        // Build nested loops
-        switch (loops.size()) {
-            case 1: {
-                auto lvl0 = splitInstructions(loops[0].body);
-                for (int i = 0; i < loops[0].repeats; ++i)
-                    result.insert(result.end(), lvl0.begin(), lvl0.end());
-                break;
-            }
-            case 2: {
-                auto l0 = splitInstructions(loops[0].body);
-                auto l1 = splitInstructions(loops[1].body);
-                for (int i = 0; i < loops[1].repeats; ++i) {
-                    result.insert(result.end(), l1.begin(), l1.end());
-                    for (int j = 0; j < loops[0].repeats; ++j)
-                        result.insert(result.end(), l0.begin(), l0.end());
-                }
-                break;
-            }
-            case 3: {
-                auto l0 = splitInstructions(loops[0].body);
-                auto l1 = splitInstructions(loops[1].body);
-                auto l2 = splitInstructions(loops[2].body);
-                for (int i = 0; i < loops[2].repeats; ++i) {
-                    result.insert(result.end(), l2.begin(), l2.end());
-                    for (int j = 0; j < loops[1].repeats; ++j) {
-                        result.insert(result.end(), l1.begin(), l1.end());
-                        for (int k = 0; k < loops[0].repeats; ++k)
-                            result.insert(result.end(), l0.begin(), l0.end());
-                    }
-                }
-                break;
-            }
-            case 4: {
-                auto l0 = splitInstructions(loops[0].body);
-                auto l1 = splitInstructions(loops[1].body);
-                auto l2 = splitInstructions(loops[2].body);
-                auto l3 = splitInstructions(loops[3].body);
-                for (int i = 0; i < loops[3].repeats; ++i) {
-                    result.insert(result.end(), l3.begin(), l3.end());
-                    for (int j = 0; j < loops[2].repeats; ++j) {
-                        result.insert(result.end(), l2.begin(), l2.end());
-                        for (int k = 0; k < loops[1].repeats; ++k) {
-                            result.insert(result.end(), l1.begin(), l1.end());
-                            for (int l = 0; l < loops[0].repeats; ++l)
-                                result.insert(result.end(), l0.begin(), l0.end());
-                        }
-                    }
-                }
-                break;
+        case OpCode::WRITE: {
+            uint16_t val = VariableManager::clamp16(operandValue(symbolTable, instr.args[1]));
+            if (!memManager.writeWord(core, pid, instr.imm, val)) {
+                raiseAccessViolation(core, instr.imm, now);
+                return;
             }
+            appendLog(core, prefix + "WRITE " + formatAddress(instr.imm) + " = " + std::to_string(val)
+                + " from " + name + "\"", false);
+            break;
         }
-
-        instructions.insert(instructions.begin() + instructionPointer, result.begin(), result.end());
-        return;
+        default:
+            break;
     }
 
     currentLine++;
-    if (currentLine >= totalLines || (instructionPointer >= instructions.size() && forLoopCounters.empty())) {
+    if (currentLine >= totalLines || (instructionPointer >= static_cast<int>(program.code.size()) && forLoopCounters.empty())) {
         isFinished = true;
     }
 }
 
+void Process::raiseAccessViolation(int core, uint32_t address, time_t time) {
+    violationAddress = address;
+    violationTime = time;
+    accessViolation = true;             // Published last, so a reader that sees it also sees the details
+    isFinished = true;
+    appendLog(core, "(" + formatTimestamp(time) + ") Core:" + std::to_string(core) + " \"Memory access violation at "
+        + formatAddress(address) + " from " + name + "\"", true);
+}
+
 // Changes process state to sleep, initializes sleepTicksRemaining value
 void Process::sleepFor(int ticks) {
     sleeping = true;
     sleepTicksRemaining = ticks;
 }
 
-// Checks the sleep state of a process, and reduces the sleep timer until 0
-void Process::tickSleep() {
-    if (sleeping && --sleepTicksRemaining <= 0) {
-        sleeping = false;
-    }
+// Called when the process's wake tick arrives
+void Process::wake() {
+    sleeping = false;
+    sleepTicksRemaining = 0;
 }
 
 // Checks the sleep state of a process
@@ -1,50 +1,85 @@
 #ifndef PROCESS_H
 #define PROCESS_H
 
+#include "instruction.h"
+#include "process_registry.h"
+#include "variable_manager.h"
 #include <string>
-#include <fstream>
+#include <mutex>
 #include <vector>
+#include <deque>
+#include <atomic>
+#include <ctime>
+#include <cstddef>
+#include <memory_resource>
 #include <stack>
 
 // Header file for process.cpp
 struct Process {
-    int pid;
+    int pid = 0;                        // MemoryManager pid, 0 when no memory is allocated
     int baseAddr = -1;
     int limitAddr = 0; 
 
+    // Only the core running the process writes its state; the atomics are also read by the console
     std::string name;
-    int currentLine;
+    std::atomic<int> currentLine;
     int totalLines;
     std::string timestamp;
     int coreAssigned;
-    bool isFinished;
-    std::ofstream logFile;
+    std::atomic<bool> isFinished;
+    time_t createdAt;
+    std::atomic<ProcessState> state{ProcessState::READY};  // Set by the scheduler as it moves the process
+    int preemptions = 0;                // Times the scheduler took the core away before finishing
 
+    // Set when a READ/WRITE touched an address outside the process's memory; the process is shut down
+    std::atomic<bool> accessViolation{false};
+    uint32_t violationAddress = 0;
+    time_t violationTime = 0;
 
-    // NEW: Store log entries in memory for screen display
-    std::deque<std::string> logs;      // Show recent logs
+    // NEW: Store log entries in memory for screen display (file output goes through processLogger)
     static const size_t MAX_LOGS = 10; // Only keep last 10
+    std::string logs[MAX_LOGS];        // Ring of recent logs; slots are overwritten in place to reuse their buffers
+    size_t logCount = 0;               // Entries ever kept, so the oldest is logs[logCount % MAX_LOGS] once full
+    std::mutex logMutex;               // logs is read by the console while a core appends
+    uint64_t logSequence = 0;          // Orders this process's records in the batched log
 
-    // Sleep state
-    bool sleeping = false;
+    // Sleep state (the scheduler parks sleeping processes in its timer wheel)
+    std::atomic<bool> sleeping{false};
     int sleepTicksRemaining = 0;
+    uint32_t delayTicksRemaining = 0;   // delay-per-exec cycles still owed when RR took the core away
     
-    // Instructions and control flow
-    std::vector<std::string> instructions;
+    // Decoded instructions and control flow
+    Program program;
+    VariableManager symbolTable{&program.arena};  // Values of program.symbols, bound to slots as they are first written
     int instructionPointer = 0;
 
-    // For loop pointer and counter
-    std::stack<int> forStartPointers;
-    std::stack<int> forLoopCounters;
+    // For loop pointer and counter (one entry per active loop, any nesting depth), kept in the program's arena
+    using LoopStack = std::stack<int, std::pmr::vector<int>>;
+    LoopStack forStartPointers{&program.arena};  // Index of the first body instruction
+    LoopStack forLoopCounters{&program.arena};   // Iterations left, including the current one
 
     Process(std::string n, int total);  // Process constructor
     Process(std::string n, int total, const std::vector<std::string>& instrs);  // Constructor with instructions
     ~Process();                         // Prcoess destructor
 
+    void setInstructions(const std::vector<std::string>& instrs);  // Compile instructions into the program
+    void releaseExecutionState();           // Free the program and loop stacks once the process is done
+
+    // Process objects come from processPool rather than the general heap
+    static void* operator new(size_t bytes);
+    static void operator delete(void* slot, size_t bytes);
+
+    const Instruction* currentInstruction(); // Next instruction to run, nullptr when done
     void executePrint(int core, int tick);  // Print into logs
+    void appendLog(int core, std::string entry, bool keepRecent); // Queue a log line
+    std::deque<std::string> recentLogs();   // Copy of the last MAX_LOGS PRINT entries
+    void raiseAccessViolation(int core, uint32_t address, time_t time);  // Shut the process down
     void sleepFor(int ticks);               // Set sleeping state
-    void tickSleep();                       // Decrement tick
+    void wake();                            // Clear sleeping state
     bool isSleeping() const;                // Check if sleeping
 };
 
+// "MM/DD/YYYY HH:MM:SSAM"; the result is valid until the next call on the same thread
+const std::string& formatTimestamp(time_t time);
+
 #endif
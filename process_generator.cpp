@@ -0,0 +1,51 @@
+#include "process_generator.h"
+#include "console.h"
+#include "config.h"
+#include "scheduler.h"
+#include "sim_clock.h"
+#include <algorithm>
+#include <climits>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+ProcessGenerator processGenerator;
+
+void ProcessGenerator::start() {
+    if (running.exchange(true)) return;
+    worker = std::thread(&ProcessGenerator::run, this);
+}
+
+void ProcessGenerator::stop() {
+    if (!running.exchange(false)) return;
+    if (worker.joinable()) worker.join();
+}
+
+void ProcessGenerator::run() {
+    uint64_t tick = simClock.join();
+    uint64_t ticksSinceSpawn = 0;
+
+    while (running.load()) {
+        if (++ticksSinceSpawn >= systemConfig.batchProcessFreq) {
+            ticksSinceSpawn = 0;
+            spawnProcess();
+        }
+        tick = simClock.awaitTick(tick);
+    }
+
+    simClock.leave();
+}
+
+void ProcessGenerator::spawnProcess() {
+    static thread_local std::mt19937 rng(std::random_device{}());
+    uint32_t minIns = systemConfig.minInstructions;
+    uint32_t maxIns = std::max(systemConfig.minInstructions, systemConfig.maxInstructions);
+    std::uniform_int_distribution<uint32_t> countDist(minIns, maxIns);
+    int count = static_cast<int>(std::min<uint32_t>(countDist(rng), INT_MAX));
+
+    std::ostringstream name;
+    name << "p" << std::setw(2) << std::setfill('0') << ++generated;
+
+    Process* p = new Process(name.str(), count, Console::generateRandomInstructions(name.str(), count));
+    scheduler.addProcess(p);
+}
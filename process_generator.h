@@ -0,0 +1,30 @@
+#ifndef PROCESS_GENERATOR_H
+#define PROCESS_GENERATOR_H
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+// Header file for process_generator.cpp
+// Background thread that creates a batch process every batch-process-freq
+// ticks, each with min-ins to max-ins random instructions. It joins the
+// clock like a core, so ticks cannot outrun process creation.
+class ProcessGenerator {
+public:
+    void start();
+    void stop();
+    bool isRunning() const { return running.load(); }
+    uint64_t getGeneratedCount() const { return generated.load(); }
+
+private:
+    std::atomic<bool> running{false};
+    std::atomic<uint64_t> generated{0};     // Also numbers the generated processes
+    std::thread worker;
+
+    void run();
+    void spawnProcess();
+};
+
+extern ProcessGenerator processGenerator;
+
+#endif
@@ -0,0 +1,205 @@
+#include "process_logger.h"
+#include "sim_clock.h"
+#include <algorithm>
+#include <iostream>
+
+ProcessLogger processLogger;
+
+bool ProcessLogger::LogRing::push(LogRecord&& record) {
+    size_t t = tail.load(std::memory_order_relaxed);
+    if (t - head.load(std::memory_order_acquire) >= CAPACITY) return false;
+
+    slots[t & (CAPACITY - 1)] = std::move(record);
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+}
+
+void ProcessLogger::LogRing::drainInto(std::vector<LogRecord>& out) {
+    size_t h = head.load(std::memory_order_relaxed);
+    size_t t = tail.load(std::memory_order_acquire);
+    for (; h != t; ++h) {
+        out.push_back(std::move(slots[h & (CAPACITY - 1)]));
+    }
+    head.store(h, std::memory_order_release);
+}
+
+ProcessLogger::Durability ProcessLogger::parseDurability(const std::string& value) {
+    return value == "exit" ? Durability::ON_EXIT : Durability::PER_TICK;
+}
+
+void ProcessLogger::start(int cores, Durability mode) {
+    if (running.load()) return;
+
+    rings.clear();
+    for (int i = 0; i < cores; i++) {
+        rings.push_back(std::make_unique<LogRing>());
+    }
+    durability = mode;
+
+    if (!listenerRegistered) {
+        simClock.addTickListener([this](uint64_t) {
+            if (durability == Durability::PER_TICK) requestDrain();
+        });
+        listenerRegistered = true;
+    }
+
+    drainRequested = false;
+    running = true;
+    writer = std::thread(&ProcessLogger::run, this);
+}
+
+void ProcessLogger::stop() {
+    if (!running.exchange(false)) return;
+    requestDrain();
+    if (writer.joinable()) writer.join();
+}
+
+void ProcessLogger::log(int core, const std::string& processName, uint64_t sequence, std::string line) {
+    if (!running.load() || rings.empty()) {
+        // No writer thread (scheduler stopped): append synchronously
+        std::lock_guard<std::mutex> lock(directMutex);
+        fileFor(processName) << line << std::endl;
+        recordProgress(processName, 1, UINT64_MAX);
+        return;
+    }
+    push(core, LogRecord{processName, sequence, std::move(line)});
+}
+
+// Lets the writer forget the log once every record before this one is written.
+// Goes through the rings too, since earlier records may still be waiting in them.
+void ProcessLogger::finish(int core, const std::string& processName, uint64_t records) {
+    if (!running.load() || rings.empty()) {
+        std::lock_guard<std::mutex> lock(directMutex);
+        recordProgress(processName, 0, records);
+        return;
+    }
+    push(core, LogRecord{processName, records, std::string(), true});
+}
+
+void ProcessLogger::push(int core, LogRecord&& record) {
+    LogRing& ring = *rings[static_cast<size_t>(core) % rings.size()];
+    while (!ring.push(std::move(record))) {
+        requestDrain();
+        std::this_thread::yield();
+    }
+
+    if (durability == Durability::ON_EXIT && ring.size() == LogRing::CAPACITY / 2) {
+        requestDrain();
+    }
+}
+
+void ProcessLogger::requestDrain() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        drainRequested = true;
+    }
+    wakeWriter.notify_one();
+}
+
+void ProcessLogger::run() {
+    std::vector<LogRecord> batch;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wakeWriter.wait(lock, [&] { return drainRequested || !running.load(); });
+            drainRequested = false;
+        }
+
+        drainAll(batch);
+        writeBatch(batch);
+        if (durability == Durability::PER_TICK) {
+            for (auto& [_, log] : openFiles) log.file.flush();
+        }
+
+        if (!running.load()) break;
+    }
+
+    // Cores have stopped by now; pick up anything logged after the last drain
+    drainAll(batch);
+    writeBatch(batch);
+    closeAll();
+}
+
+void ProcessLogger::drainAll(std::vector<LogRecord>& batch) {
+    for (auto& ring : rings) {
+        ring->drainInto(batch);
+    }
+}
+
+void ProcessLogger::writeBatch(std::vector<LogRecord>& batch) {
+    if (batch.empty()) return;
+
+    std::stable_sort(batch.begin(), batch.end(), [](const LogRecord& a, const LogRecord& b) {
+        if (a.processName != b.processName) return a.processName < b.processName;
+        return a.sequence < b.sequence;
+    });
+
+    // One write per process per batch; a finish marker sorts after the process's records
+    std::string buffer;
+    for (size_t i = 0; i < batch.size(); ) {
+        const std::string& name = batch[i].processName;
+        uint64_t lines = 0;
+        uint64_t expected = UINT64_MAX;
+        buffer.clear();
+        for (; i < batch.size() && batch[i].processName == name; ++i) {
+            if (batch[i].last) {
+                expected = batch[i].sequence;
+                continue;
+            }
+            buffer += batch[i].line;
+            buffer += '\n';
+            lines++;
+        }
+        if (lines > 0) fileFor(name).write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        recordProgress(name, lines, expected);
+    }
+    batch.clear();
+}
+
+// Once a finished process's records are all written, its file is closed and its name forgotten
+void ProcessLogger::recordProgress(const std::string& processName, uint64_t written, uint64_t expected) {
+    auto it = started.find(processName);
+    if (it == started.end()) return;
+    LogProgress& progress = it->second;
+    progress.written += written;
+    if (expected != UINT64_MAX) progress.expected = expected;
+    if (progress.written < progress.expected) return;
+
+    auto open = openFiles.find(processName);
+    if (open != openFiles.end()) {
+        recentFiles.erase(open->second.recent);
+        openFiles.erase(open);
+    }
+    started.erase(it);
+}
+
+void ProcessLogger::closeAll() {
+    openFiles.clear();  // Closing flushes
+    recentFiles.clear();
+}
+
+std::ofstream& ProcessLogger::fileFor(const std::string& processName) {
+    auto it = openFiles.find(processName);
+    if (it != openFiles.end()) {
+        recentFiles.splice(recentFiles.begin(), recentFiles, it->second.recent);
+        return it->second.file;
+    }
+
+    // Close only the least recently written file, so active logs stay open
+    if (openFiles.size() >= MAX_OPEN_FILES) {
+        openFiles.erase(recentFiles.back());  // Closing flushes
+        recentFiles.pop_back();
+    }
+
+    // The first write of a session replaces any log left over from a previous run
+    bool fresh = started.try_emplace(processName).second;
+    recentFiles.push_front(processName);
+    OpenLog& log = openFiles[processName];
+    log.recent = recentFiles.begin();
+    log.file.open(processName + "_log.txt", fresh ? std::ios::trunc : std::ios::app);
+    if (!log.file.is_open()) {
+        std::cerr << "Failed to open log file for " << processName << "\n";
+    }
+    return log.file;
+}
@@ -0,0 +1,95 @@
+#ifndef PROCESS_LOGGER_H
+#define PROCESS_LOGGER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Header file for process_logger.cpp
+// Process log records are pushed into a lock-free ring per core and written
+// to <process>_log.txt in batches by a single writer thread, so instruction
+// execution never does file I/O and processes do not hold file descriptors.
+class ProcessLogger {
+public:
+    enum class Durability {
+        PER_TICK,   // Drain and flush every clock tick
+        ON_EXIT     // Drain only when a ring fills up and on stop()
+    };
+
+    static Durability parseDurability(const std::string& value);  // "tick" or "exit"
+
+    void start(int cores, Durability mode);
+    void stop();                                // Drains every ring before returning
+    void log(int core, const std::string& processName, uint64_t sequence, std::string line);
+    void finish(int core, const std::string& processName, uint64_t records);  // The process logged its last record
+
+private:
+    struct LogRecord {
+        std::string processName;
+        uint64_t sequence = 0;  // Per-process order, since a process can move between cores
+        std::string line;
+        bool last = false;      // No line; sequence is how many records the process logged in total
+    };
+
+    // Single-producer (one core) / single-consumer (the writer) ring buffer
+    struct LogRing {
+        static const size_t CAPACITY = 1024;    // Power of two
+        LogRecord slots[CAPACITY];
+        alignas(64) std::atomic<size_t> head{0}; // Next record the writer reads
+        alignas(64) std::atomic<size_t> tail{0}; // Next slot the core writes
+
+        bool push(LogRecord&& record);
+        void drainInto(std::vector<LogRecord>& out);
+        size_t size() const { return tail.load() - head.load(); }
+    };
+
+    static const size_t MAX_OPEN_FILES = 64;
+
+    std::vector<std::unique_ptr<LogRing>> rings;
+    std::atomic<bool> running{false};
+    Durability durability = Durability::PER_TICK;
+    bool listenerRegistered = false;
+
+    std::mutex wakeMutex;
+    std::condition_variable wakeWriter;
+    bool drainRequested = false;
+    std::thread writer;
+
+    struct OpenLog {
+        std::ofstream file;
+        std::list<std::string>::iterator recent;   // Position in recentFiles
+    };
+
+    // Logs started in this session, kept until the process's last record is written
+    struct LogProgress {
+        uint64_t written = 0;
+        uint64_t expected = UINT64_MAX;         // Known once the process has finished
+    };
+
+    // Writer-side state
+    std::unordered_map<std::string, OpenLog> openFiles;
+    std::list<std::string> recentFiles;         // Open files, most recently written first
+    std::unordered_map<std::string, LogProgress> started;
+    std::mutex directMutex;                     // Used while the writer is not running
+
+    void requestDrain();
+    void run();
+    void drainAll(std::vector<LogRecord>& batch);
+    void writeBatch(std::vector<LogRecord>& batch);
+    void push(int core, LogRecord&& record);
+    std::ofstream& fileFor(const std::string& processName);
+    void recordProgress(const std::string& processName, uint64_t written, uint64_t expected);
+    void closeAll();
+};
+
+extern ProcessLogger processLogger;
+
+#endif
@@ -0,0 +1,76 @@
+#include "process_pool.h"
+#include "process.h"
+#include <new>
+
+ProcessPool processPool(sizeof(Process));
+
+static_assert(alignof(Process) <= alignof(std::max_align_t), "process slots are only max_align_t aligned");
+
+static size_t roundUp(size_t bytes) {
+    const size_t align = alignof(std::max_align_t);
+    return (bytes + align - 1) / align * align;
+}
+
+ProcessPool::ProcessPool(size_t bytes)
+    : slotBytes(roundUp(bytes < sizeof(FreeSlot) ? sizeof(FreeSlot) : bytes)), headerBytes(roundUp(sizeof(Slab))) {}
+
+ProcessPool::~ProcessPool() {
+    while (slabs) {
+        Slab* next = slabs->next;
+        ::operator delete(slabs);
+        slabs = next;
+    }
+}
+
+void ProcessPool::grow() {
+    char* memory = static_cast<char*>(::operator new(headerBytes + SLAB_SLOTS * slotBytes));
+    Slab* slab = reinterpret_cast<Slab*>(memory);
+    slab->next = slabs;
+    slabs = slab;
+    slabCount++;
+
+    // Thread the new slots onto the free list, lowest address first
+    for (size_t i = SLAB_SLOTS; i-- > 0; ) {
+        FreeSlot* slot = reinterpret_cast<FreeSlot*>(memory + headerBytes + i * slotBytes);
+        slot->next = freeList;
+        freeList = slot;
+    }
+}
+
+void* ProcessPool::allocate(size_t bytes) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (bytes > slotBytes) {
+        oversized++;
+        return ::operator new(bytes);
+    }
+
+    if (!freeList) grow();
+    FreeSlot* slot = freeList;
+    freeList = slot->next;
+    live++;
+    allocations++;
+    return slot;
+}
+
+void ProcessPool::deallocate(void* slot, size_t bytes) {
+    if (!slot) return;
+    if (bytes > slotBytes) {
+        ::operator delete(slot);
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(lock);
+    FreeSlot* freed = static_cast<FreeSlot*>(slot);
+    freed->next = freeList;
+    freeList = freed;
+    live--;
+}
+
+void ProcessPool::writeCounters(std::ostream& out) const {
+    std::lock_guard<std::mutex> guard(lock);
+    out << "pool.process.slot_bytes " << slotBytes << "\n";
+    out << "pool.process.slabs " << slabCount << "\n";
+    out << "pool.process.live " << live << "\n";
+    out << "pool.process.allocations " << allocations << "\n";
+    out << "pool.process.oversized " << oversized << "\n";
+}
@@ -0,0 +1,50 @@
+#ifndef PROCESS_POOL_H
+#define PROCESS_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+
+// Header file for process_pool.cpp
+// Fixed-size slots for Process objects, carved from slabs of SLAB_SLOTS at a
+// time. Freed slots go on an intrusive free list and are never returned to
+// the heap, so a steady stream of created and reclaimed processes reuses the
+// same memory instead of calling new/delete for every process.
+class ProcessPool {
+public:
+    static const size_t SLAB_SLOTS = 64;
+
+    explicit ProcessPool(size_t slotBytes);
+    ProcessPool(const ProcessPool&) = delete;
+    ProcessPool& operator=(const ProcessPool&) = delete;
+    ~ProcessPool();
+
+    void* allocate(size_t bytes);       // Falls back to the heap if bytes does not fit a slot
+    void deallocate(void* slot, size_t bytes);
+    void writeCounters(std::ostream& out) const;  // "name value" lines for vmstat --raw
+
+private:
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+    struct Slab {
+        Slab* next;
+    };
+
+    size_t slotBytes;
+    size_t headerBytes;                 // Slab header, padded so slots stay aligned
+    mutable std::mutex lock;
+    FreeSlot* freeList = nullptr;
+    Slab* slabs = nullptr;
+    uint64_t slabCount = 0;
+    uint64_t live = 0;
+    uint64_t allocations = 0;
+    uint64_t oversized = 0;             // Requests that went straight to the heap
+
+    void grow();                        // Caller holds lock
+};
+
+extern ProcessPool processPool;
+
+#endif
@@ -0,0 +1,84 @@
+#include "process_registry.h"
+#include "process.h"
+#include <mutex>
+
+const char* processStateName(ProcessState state) {
+    switch (state) {
+        case ProcessState::READY: return "Ready";
+        case ProcessState::RUNNING: return "Running";
+        case ProcessState::SLEEPING: return "Sleeping";
+        case ProcessState::FINISHED: return "Finished";
+    }
+    return "Unknown";
+}
+
+void ProcessRegistry::add(Process* p) {
+    {
+        Shard& shard = nameShard(p->name);
+        std::unique_lock<std::shared_mutex> lock(shard.lock);
+        auto [it, inserted] = shard.byName.try_emplace(p->name, p);
+        if (inserted) count++;
+        else it->second = p;
+    }
+    if (p->pid > 0) {
+        Shard& shard = pidShard(p->pid);
+        std::unique_lock<std::shared_mutex> lock(shard.lock);
+        shard.byPid[p->pid] = p;
+    }
+}
+
+void ProcessRegistry::remove(Process* p) {
+    {
+        // Leave the name alone if a newer process has taken it over
+        Shard& shard = nameShard(p->name);
+        std::unique_lock<std::shared_mutex> lock(shard.lock);
+        auto it = shard.byName.find(p->name);
+        if (it != shard.byName.end() && it->second == p) {
+            shard.byName.erase(it);
+            count--;
+        }
+    }
+    if (p->pid > 0) {
+        Shard& shard = pidShard(p->pid);
+        std::unique_lock<std::shared_mutex> lock(shard.lock);
+        auto it = shard.byPid.find(p->pid);
+        if (it != shard.byPid.end() && it->second == p) shard.byPid.erase(it);
+    }
+}
+
+Process* ProcessRegistry::findByName(const std::string& name) const {
+    const Shard& shard = nameShard(name);
+    std::shared_lock<std::shared_mutex> lock(shard.lock);
+    auto it = shard.byName.find(name);
+    return it != shard.byName.end() ? it->second : nullptr;
+}
+
+Process* ProcessRegistry::findByPid(int pid) const {
+    if (pid <= 0) return nullptr;
+    const Shard& shard = pidShard(pid);
+    std::shared_lock<std::shared_mutex> lock(shard.lock);
+    auto it = shard.byPid.find(pid);
+    return it != shard.byPid.end() ? it->second : nullptr;
+}
+
+void ProcessRegistry::addFinished(const std::string& name, uint64_t record) {
+    Shard& shard = nameShard(name);
+    std::unique_lock<std::shared_mutex> lock(shard.lock);
+    shard.finishedByName[name] = record;
+}
+
+void ProcessRegistry::removeFinished(const std::string& name, uint64_t record) {
+    Shard& shard = nameShard(name);
+    std::unique_lock<std::shared_mutex> lock(shard.lock);
+    auto it = shard.finishedByName.find(name);
+    if (it != shard.finishedByName.end() && it->second == record) shard.finishedByName.erase(it);
+}
+
+bool ProcessRegistry::findFinished(const std::string& name, uint64_t& record) const {
+    const Shard& shard = nameShard(name);
+    std::shared_lock<std::shared_mutex> lock(shard.lock);
+    auto it = shard.finishedByName.find(name);
+    if (it == shard.finishedByName.end()) return false;
+    record = it->second;
+    return true;
+}
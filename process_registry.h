@@ -0,0 +1,61 @@
+#ifndef PROCESS_REGISTRY_H
+#define PROCESS_REGISTRY_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+struct Process;
+
+// Where a process is in its life; kept in the process itself so changing it never touches the registry
+enum class ProcessState : uint8_t {
+    READY,      // In a run queue
+    RUNNING,    // On a core
+    SLEEPING,   // Parked in the timer wheel
+    FINISHED
+};
+
+const char* processStateName(ProcessState state);
+
+// Header file for process_registry.cpp
+// Name -> process and pid -> process lookup for every process the scheduler
+// knows about, whatever its state, plus name -> summary record for finished
+// processes. The maps are split into shards with their own reader/writer
+// locks, so a lookup is O(1) and only ever waits for an add or remove in the
+// same shard, never for dispatch.
+class ProcessRegistry {
+public:
+    void add(Process* p);       // A newer process with the same name replaces the old one in name lookups
+    void remove(Process* p);
+    Process* findByName(const std::string& name) const;
+    Process* findByPid(int pid) const;  // Memory manager pid; processes without memory have none
+    size_t size() const { return count.load(); }
+
+    // Finished processes, by the name stored in their summary record
+    void addFinished(const std::string& name, uint64_t record);
+    void removeFinished(const std::string& name, uint64_t record);  // Only if the name still maps to record
+    bool findFinished(const std::string& name, uint64_t& record) const;
+
+private:
+    static const size_t SHARDS = 16;
+
+    struct Shard {
+        mutable std::shared_mutex lock;
+        std::unordered_map<std::string, Process*> byName;
+        std::unordered_map<int, Process*> byPid;
+        std::unordered_map<std::string, uint64_t> finishedByName;
+    };
+
+    Shard shards[SHARDS];
+    std::atomic<size_t> count{0};
+
+    Shard& nameShard(const std::string& name) { return shards[std::hash<std::string>{}(name) % SHARDS]; }
+    const Shard& nameShard(const std::string& name) const { return shards[std::hash<std::string>{}(name) % SHARDS]; }
+    Shard& pidShard(int pid) { return shards[static_cast<size_t>(pid) % SHARDS]; }
+    const Shard& pidShard(int pid) const { return shards[static_cast<size_t>(pid) % SHARDS]; }
+};
+
+#endif
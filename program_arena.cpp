@@ -0,0 +1,101 @@
+#include "program_arena.h"
+#include <new>
+
+BlockPool programBlocks;
+
+size_t BlockPool::blockSizeFor(size_t bytes) {
+    size_t size = MIN_BLOCK;
+    while (size < bytes) size <<= 1;
+    return size;
+}
+
+int BlockPool::classOf(size_t blockSize) {
+    int index = 0;
+    for (size_t size = MIN_BLOCK; size < blockSize; size <<= 1) index++;
+    return index < SIZE_CLASSES ? index : -1;
+}
+
+void* BlockPool::acquire(size_t blockSize) {
+    int index = classOf(blockSize);
+    std::lock_guard<std::mutex> guard(lock);
+    if (index == -1) {
+        largeAllocations++;
+        return ::operator new(blockSize);
+    }
+
+    blocksInUse++;
+    bytesInUse += blockSize;
+    if (FreeBlock* block = freeLists[index]) {
+        freeLists[index] = block->next;
+        blockReuses++;
+        return block;
+    }
+    heapBlocks++;
+    heapBytes += blockSize;
+    return ::operator new(blockSize);
+}
+
+void BlockPool::release(void* block, size_t blockSize) {
+    int index = classOf(blockSize);
+    if (index == -1) {
+        ::operator delete(block);
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(lock);
+    blocksInUse--;
+    bytesInUse -= blockSize;
+    FreeBlock* freed = static_cast<FreeBlock*>(block);
+    freed->next = freeLists[index];
+    freeLists[index] = freed;
+}
+
+void BlockPool::writeCounters(std::ostream& out) const {
+    std::lock_guard<std::mutex> guard(lock);
+    out << "pool.program.heap_blocks " << heapBlocks << "\n";
+    out << "pool.program.heap_bytes " << heapBytes << "\n";
+    out << "pool.program.blocks_in_use " << blocksInUse << "\n";
+    out << "pool.program.bytes_in_use " << bytesInUse << "\n";
+    out << "pool.program.block_reuses " << blockReuses << "\n";
+    out << "pool.program.large_allocations " << largeAllocations << "\n";
+}
+
+static uintptr_t alignUp(uintptr_t address, size_t alignment) {
+    return (address + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+}
+
+void ProgramArena::addBlock(size_t bytes) {
+    size_t size = BlockPool::blockSizeFor(sizeof(BlockHeader) + bytes);
+    BlockHeader* block = static_cast<BlockHeader*>(programBlocks.acquire(size));
+    block->next = blocks;
+    block->size = size;
+    blocks = block;
+
+    cursor = reinterpret_cast<char*>(block + 1);
+    limit = reinterpret_cast<char*>(block) + size;
+}
+
+void ProgramArena::reserve(size_t bytes) {
+    if (!blocks) addBlock(bytes);
+}
+
+void* ProgramArena::do_allocate(size_t bytes, size_t alignment) {
+    uintptr_t aligned = alignUp(reinterpret_cast<uintptr_t>(cursor), alignment);
+    if (!cursor || aligned + bytes > reinterpret_cast<uintptr_t>(limit)) {
+        // Start a new block; whatever is left of the old one waits for release()
+        addBlock(bytes + alignment);
+        aligned = alignUp(reinterpret_cast<uintptr_t>(cursor), alignment);
+    }
+
+    cursor = reinterpret_cast<char*>(aligned + bytes);
+    return reinterpret_cast<void*>(aligned);
+}
+
+void ProgramArena::release() {
+    while (blocks) {
+        BlockHeader* next = blocks->next;
+        programBlocks.release(blocks, blocks->size);
+        blocks = next;
+    }
+    cursor = limit = nullptr;
+}
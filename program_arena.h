@@ -0,0 +1,73 @@
+#ifndef PROGRAM_ARENA_H
+#define PROGRAM_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+#include <ostream>
+
+// Header file for program_arena.cpp
+// Power-of-two blocks shared by every process's program storage. A returned
+// block goes on the free list for its size and is handed out again before the
+// heap is asked for more, so once the pool has grown to cover the live
+// programs, creating and finishing processes stops allocating.
+class BlockPool {
+public:
+    static const size_t MIN_BLOCK = 128;
+    static const int SIZE_CLASSES = 14; // 128 bytes up to 1 MB; larger requests bypass the pool
+
+    static size_t blockSizeFor(size_t bytes);   // Rounded up to a size class
+    void* acquire(size_t blockSize);
+    void release(void* block, size_t blockSize);
+    void writeCounters(std::ostream& out) const;  // "name value" lines for vmstat --raw
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    static int classOf(size_t blockSize);       // -1 above the largest class
+
+    mutable std::mutex lock;
+    FreeBlock* freeLists[SIZE_CLASSES] = {};
+    uint64_t heapBlocks = 0;            // Blocks ever taken from the heap
+    uint64_t heapBytes = 0;
+    uint64_t blocksInUse = 0;
+    uint64_t bytesInUse = 0;
+    uint64_t blockReuses = 0;           // Requests served from a free list
+    uint64_t largeAllocations = 0;      // Requests over the largest class
+};
+
+extern BlockPool programBlocks;
+
+// Bump allocator over blocks from programBlocks. Individual frees do nothing;
+// release() hands every block back at once when the program is no longer needed.
+class ProgramArena : public std::pmr::memory_resource {
+public:
+    ProgramArena() = default;
+    ProgramArena(const ProgramArena&) = delete;
+    ProgramArena& operator=(const ProgramArena&) = delete;
+    ~ProgramArena() override { release(); }
+
+    void reserve(size_t bytes);         // Size the first block for a known footprint; no-op once allocating
+    void release();
+
+private:
+    // Start of every block, linking the blocks this arena holds
+    struct BlockHeader {
+        BlockHeader* next;
+        size_t size;
+    };
+
+    BlockHeader* blocks = nullptr;
+    char* cursor = nullptr;
+    char* limit = nullptr;
+
+    void addBlock(size_t bytes);        // Becomes the block being allocated from
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+#endif
@@ -1,230 +1,446 @@
 #include "scheduler.h"
 #include "memory_manager.h"
+#include "sim_clock.h"
+#include "process_logger.h"
 #include <iostream>
 #include <fstream> 
 #include <iomanip>
-#include <chrono>
+#include <sstream>
 #include <thread>
 #include <algorithm>
+#include <cstring>
+#include <utility>
 
 std::mutex consoleMutex;
-std::mutex processMutex;
 std::atomic<bool> schedulerRunning(false);
-FCFSScheduler scheduler;
-std::atomic<int> cpuTickCount(0);
+Scheduler scheduler;
 
-FCFSScheduler::FCFSScheduler(int cores) : coreCount(cores) {
-    runningProcesses.resize(coreCount, nullptr);
+std::unique_ptr<SchedulingPolicy> makeSchedulingPolicy(const SystemConfig& config) {
+    if (config.scheduler == "rr") {
+        return std::make_unique<RRPolicy>(config.quantumCycles);
+    }
+    return std::make_unique<FCFSPolicy>();
 }
 
-void FCFSScheduler::addProcess(Process* p) {
-    std::lock_guard<std::mutex> lock(processMutex);
-    readyQueue.push(p);
+Scheduler::Scheduler(int cores) : policy(std::make_unique<FCFSPolicy>()), coreCount(0) {
+    setCoreCount(cores);
 }
 
-Process* FCFSScheduler::findProcess(const std::string& name) {
-    std::lock_guard<std::mutex> lock(processMutex);
+void Scheduler::setPolicy(std::unique_ptr<SchedulingPolicy> newPolicy) {
+    policy = std::move(newPolicy);
+}
 
-    for (auto* p : runningProcesses) {
-        if (p && p->name == name) return p;
+void Scheduler::setFinishedRetention(size_t records) {
+    finishedProcesses.setRetention(records);
+}
+
+void Scheduler::setCoreCount(int cores) {
+    // Keep anything already queued so it can be redistributed over the new cores
+    std::vector<Process*> pending;
+    for (auto& rq : runQueues) {
+        pending.insert(pending.end(), rq->processes.begin(), rq->processes.end());
     }
 
-    std::queue<Process*> tempQueue = readyQueue;
-    while (!tempQueue.empty()) {
-        Process* p = tempQueue.front();
-        tempQueue.pop();
-        if (p && p->name == name) return p;
+    coreCount = cores;
+    runQueues.clear();
+    for (int i = 0; i < coreCount; i++) {
+        runQueues.push_back(std::make_unique<RunQueue>());
     }
+    runningProcesses = std::vector<std::atomic<Process*>>(coreCount);
+    coreStats = std::vector<CoreStats>(coreCount);
+    queuedCount = 0;
 
-    for (auto* p : finishedProcesses) {
-        if (p && p->name == name) return p;
+    for (auto* p : pending) addProcess(p);
+}
+
+void Scheduler::addProcess(Process* p) {
+    registry.add(p);
+    enqueue(nextQueue++ % coreCount, p);
+}
+
+void Scheduler::enqueue(int queueIndex, Process* p) {
+    RunQueue& rq = *runQueues[queueIndex];
+    p->state = ProcessState::READY;
+    {
+        std::lock_guard<std::mutex> lock(rq.lock);
+        rq.processes.push_back(p);
+        rq.size++;
     }
+    queuedCount++;
+
+    // A core about to park raises parkedCores before it checks queuedCount, so with both seq_cst
+    // either it sees this process or this sees it parking. Only then is idleMutex worth taking,
+    // to order the notify after its wait; with every core busy the dispatch path stays lock-free.
+    if (parkedCores.load() == 0) return;
+    { std::lock_guard<std::mutex> lock(idleMutex); }
+    workAvailable.notify_one();
+}
 
+Process* Scheduler::popLocal(int coreId) {
+    RunQueue& rq = *runQueues[coreId];
+    if (rq.size.load() == 0) return nullptr;
+
+    std::lock_guard<std::mutex> lock(rq.lock);
+    if (rq.processes.empty()) return nullptr;
+    Process* p = rq.processes.front();
+    rq.processes.pop_front();
+    rq.size--;
+    queuedCount--;
+    return p;
+}
+
+Process* Scheduler::steal(int coreId) {
+    for (int i = 1; i < coreCount; i++) {
+        RunQueue& victim = *runQueues[(coreId + i) % coreCount];
+        if (victim.size.load() == 0) continue;
+
+        std::lock_guard<std::mutex> lock(victim.lock);
+        if (victim.processes.empty()) continue;
+        Process* p = victim.processes.back();
+        victim.processes.pop_back();
+        victim.size--;
+        queuedCount--;
+        return p;
+    }
     return nullptr;
 }
 
-const std::vector<Process*>& FCFSScheduler::getRunningProcesses() const {
-    return runningProcesses;
+Process* Scheduler::findProcess(const std::string& name) {
+    return registry.findByName(name);
 }
 
-int extractPageFromInstruction(const std::string& instr, const Process* p, int pageSize) {
-    // Check if instruction is READ or WRITE
-    // Format examples:
-    // READ var 0x1000
-    // WRITE 0x2000 42
+Process* Scheduler::findProcessByPid(int pid) {
+    return registry.findByPid(pid);
+}
 
-    std::istringstream iss(instr);
-    std::string opcode;
-    iss >> opcode;
+bool Scheduler::findFinished(const std::string& name, ProcessSummary& summary) const {
+    uint64_t record;
+    std::string key = name.substr(0, ProcessSummary::NAME_LENGTH - 1);  // Summaries store cut-short names
+    return registry.findFinished(key, record) && finishedProcesses.find(record, summary);
+}
 
-    if (opcode == "READ") {
-        std::string varName, addrHex;
-        iss >> varName >> addrHex;
-        if (addrHex.size() >= 3 && addrHex.substr(0,2) == "0x") {
-            int addr = std::stoi(addrHex, nullptr, 16);
-            int pageNum = (addr - p->baseAddr) / pageSize;
-            if (pageNum >= 0) return pageNum;
-        }
-    } else if (opcode == "WRITE") {
-        std::string addrHex;
-        iss >> addrHex;
-        if (addrHex.size() >= 3 && addrHex.substr(0,2) == "0x") {
-            int addr = std::stoi(addrHex, nullptr, 16);
-            int pageNum = (addr - p->baseAddr) / pageSize;
-            if (pageNum >= 0) return pageNum;
+// Shrinks a finished process to its summary record and frees everything else it held right away.
+// The Process itself is kept until reclaimRetired(), since the console may still be looking at it.
+// Called on the process's core, which still shows it as running until the record is in place.
+void Scheduler::retire(Process* p, int coreId) {
+    ProcessSummary summary{};
+    std::strncpy(summary.name, p->name.c_str(), ProcessSummary::NAME_LENGTH - 1);
+    summary.pid = p->pid;
+    summary.core = coreId;
+    summary.linesExecuted = p->currentLine;
+    summary.totalLines = p->totalLines;
+    summary.preemptions = p->preemptions;
+    summary.createdAt = p->createdAt;
+    summary.accessViolation = p->accessViolation;
+    summary.violationAddress = p->violationAddress;
+    summary.finishedAt = summary.accessViolation ? p->violationTime : time(nullptr);
+
+    if (p->pid > 0) {
+        MemoryManager::PagingSummary paging;
+        memManager.deallocateProcess(p->name, &paging);
+        summary.pageFaults = paging.faults;
+        summary.pageIns = paging.pageIns;
+        summary.pageOuts = paging.pageOuts;
+    }
+    p->releaseExecutionState();
+    processLogger.finish(coreId, p->name, p->logSequence);
+
+    // Leaving the core and joining the finished list look like one step to takeSnapshot()
+    std::vector<std::shared_ptr<const FinishedList::Chunk>> dropped;
+    finishesBegun++;
+    runningProcesses[coreId] = nullptr;
+    p->state = ProcessState::FINISHED;
+    uint64_t record = finishedProcesses.append(summary, dropped);
+    finishesEnded++;
+
+    registry.addFinished(summary.name, record);
+    registry.remove(p);
+    for (const auto& chunk : dropped) {
+        for (size_t i = 0; i < FinishedList::CHUNK_RECORDS; i++) {
+            registry.removeFinished(chunk->records[i].name, chunk->base + i);
         }
     }
 
-    return -1; // no page access
+    std::lock_guard<std::mutex> lock(retiredMutex);
+    retired.push_back(p);
+}
+
+void Scheduler::reclaimRetired() {
+    std::vector<Process*> batch;
+    {
+        std::lock_guard<std::mutex> lock(retiredMutex);
+        batch.swap(retired);
+    }
+    for (auto* p : batch) {
+        delete p;
+    }
+}
+
+const std::vector<std::atomic<Process*>>& Scheduler::getRunningProcesses() const {
+    return runningProcesses;
 }
 
-const std::vector<Process*>& FCFSScheduler::getFinishedProcesses() const {
-    return finishedProcesses;
+void Scheduler::wakeSleepers(uint64_t tick) {
+    std::vector<Process*> expired;
+    sleepers.advance(tick, expired);
+    for (auto* p : expired) {
+        p->wake();
+        simClock.release();
+        enqueue(p->coreAssigned >= 0 ? p->coreAssigned : 0, p);  // Prefer the core it last ran on
+    }
 }
 
-void FCFSScheduler::start() {
-    schedulerRunning = true;
+void Scheduler::start() {
+    if (schedulerRunning.exchange(true)) return;
+    simClock.setTickMillis(systemConfig.tickMillis);
+    if (!clockListenerRegistered) {
+        simClock.addTickListener([this](uint64_t tick) { wakeSleepers(tick); });
+        clockListenerRegistered = true;
+    }
+    if (sleepers.pending() == 0) sleepers.reset(simClock.now());
+    processLogger.start(coreCount, ProcessLogger::parseDurability(systemConfig.logFlush));
+
+    // Every core joins the clock before it starts, so no tick can pass without them
+    for (int i = 0; i < coreCount; i++) {
+        simClock.join();
+    }
+    simClock.start();
+
     for (int i = 0; i < coreCount; i++) {
-        workerThreads.emplace_back(&FCFSScheduler::workerThread, this, i);
+        workerThreads.emplace_back(&Scheduler::workerThread, this, i);
     }
 }
 
-void FCFSScheduler::stop() {
+void Scheduler::stop() {
     schedulerRunning = false;
+    {
+        std::lock_guard<std::mutex> lock(idleMutex);
+    }
+    workAvailable.notify_all();
+    simClock.stop();
     for (auto& t : workerThreads) {
         if (t.joinable()) t.join();
     }
+    workerThreads.clear();
+    processLogger.stop();
 
-    for (auto* p : finishedProcesses) {
-        delete p;
-    }
-    finishedProcesses.clear();
+    reclaimRetired();
 }
 
-void FCFSScheduler::workerThread(int coreId) {
+void Scheduler::workerThread(int coreId) {
+    uint64_t tick = simClock.now();
+
     while (schedulerRunning) {
-        Process* p = nullptr;
-
-        {
-            std::lock_guard<std::mutex> lock(processMutex);
-            if (!readyQueue.empty()) {
-                p = readyQueue.front();
-                readyQueue.pop();
-                runningProcesses[coreId] = p;
-                p->coreAssigned = coreId;
+        Process* p = popLocal(coreId);
+        if (!p) p = steal(coreId);
+
+        if (!p) {
+            // Park until there is work, without holding back the clock meanwhile
+            uint64_t parkedAt = simClock.now();
+            coreStats[coreId].parkedSince = parkedAt;
+            simClock.leave();
+            {
+                std::unique_lock<std::mutex> lock(idleMutex);
+                parkedCores++;
+                workAvailable.wait(lock, [&] { return !schedulerRunning || queuedCount.load() > 0; });
+                parkedCores--;
             }
+            tick = simClock.join();
+            coreStats[coreId].idleTicks += tick - parkedAt;
+            coreStats[coreId].parkedSince = NOT_PARKED;
+            continue;
         }
 
-        if (p) {
-            while (!p->isFinished && schedulerRunning) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(150));
-                cpuTickCount++;
+        p->coreAssigned = coreId;
+        p->state = ProcessState::RUNNING;
+        runningProcesses[coreId] = p;
+        contextSwitches++;
 
-                if (p->isSleeping()) {
-                    p->tickSleep();
-                    continue;
-                }
+        uint32_t cyclesOnCore = 0;
+        uint32_t delayRemaining = std::exchange(p->delayTicksRemaining, 0);  // delay-per-exec cycles left before the next instruction
+        bool preempted = false;
 
-                if (p->instructions.empty() || p->isFinished) continue;
+        while (!p->isFinished && schedulerRunning) {
+            tick = simClock.awaitTick(tick);
+            cyclesOnCore++;
+            coreStats[coreId].busyTicks++;
 
-                const auto& instr = p->instructions[p->currentLine];
-                int pageNum = extractPageFromInstruction(instr, p, memManager.getPageSize());
-                if (pageNum != -1) {
-                    memManager.accessPage(p->name, pageNum);
-                }
+            if (delayRemaining > 0) {
+                delayRemaining--;
+            } else if (!p->program.empty() && !p->isFinished) {
+                p->executePrint(coreId, static_cast<int>(tick));
+                delayRemaining = systemConfig.delayPerExec;
 
-                p->executePrint(coreId, cpuTickCount.load());
+                if (p->isSleeping()) break;   // Give up the core until the timer wheel wakes it
             }
 
-            {
-                std::lock_guard<std::mutex> lock(processMutex);
-                runningProcesses[coreId] = nullptr;
-                finishedProcesses.push_back(p);
+            if (!p->isFinished && policy->shouldPreempt(cyclesOnCore)) {
+                preempted = true;
+                break;
+            }
+        }
+
+        bool parked = p->isSleeping() && schedulerRunning;
+        if (!parked && !preempted) {
+            retire(p, coreId);
+            continue;
+        }
+
+        runningProcesses[coreId] = nullptr;
+        if (parked) {
+            p->state = ProcessState::SLEEPING;
+            simClock.retain();
+            if (!sleepers.schedule(p, tick + p->sleepTicksRemaining)) {
+                simClock.release();
+                p->wake();
+                enqueue(coreId, p);
             }
+        } else {
+            p->preemptions++;
+            p->delayTicksRemaining = delayRemaining;    // Carried to whichever core runs it next
+            enqueue(coreId, p);
         }
     }
-}
 
-void FCFSScheduler::printStatus() {
-    std::lock_guard<std::mutex> lock(processMutex);
-    std::lock_guard<std::mutex> consoleLock(consoleMutex);
+    simClock.leave();
+}
 
-    std::cout << "\n----------------------------------------------------\n";
-    std::cout << "Running processes:\n";
+Scheduler::StatusSnapshot Scheduler::takeSnapshot() const {
+    StatusSnapshot snapshot;
+
+    // Retry while a process is between its core and the finished list, so it is listed exactly once.
+    // Gives up after a few attempts rather than keep the console waiting on a busy scheduler.
+    for (int attempt = 0; attempt < 64; attempt++) {
+        uint64_t ended = finishesEnded.load();
+        uint64_t begun = finishesBegun.load();
+        if (begun != ended) {
+            std::this_thread::yield();
+            continue;
+        }
 
-    bool anyRunning = false;
-    for (int i = 0; i < coreCount; i++) {
-        Process* p = runningProcesses[i];
-        if (p) {
-            anyRunning = true;
-            std::cout << std::left << std::setw(12) << p->name
-                      << " (" << p->timestamp << ")"
-                      << "   Core: " << i
-                      << "   " << p->currentLine << " / " << p->totalLines << "\n";
+        snapshot.running.clear();
+        for (int i = 0; i < coreCount; i++) {
+            Process* p = runningProcesses[i].load();
+            if (p) snapshot.running.push_back({p->name, p->timestamp, i, p->currentLine.load(), p->totalLines});
         }
-    }
-    if (!anyRunning) {
-        std::cout << "None\n";
+        snapshot.finished = finishedProcesses.snapshot();
+        if (finishesBegun.load() == begun) break;
     }
 
-    std::cout << "\nFinished processes:\n";
-    if (finishedProcesses.empty()) {
-        std::cout << "None\n";
-    } else {
-        for (auto* p : finishedProcesses) {
-            std::cout << std::left << std::setw(12) << p->name
-                      << " (" << p->timestamp << ")"
-                      << "   Finished"
-                      << "   " << p->totalLines << " / " << p->totalLines << "\n";
-        }
+    for (int i = 0; i < coreCount; i++) {
+        uint64_t busy, idle;
+        getCoreTicks(i, busy, idle);
+        snapshot.busyTicks.push_back(busy);
+        snapshot.idleTicks.push_back(idle);
     }
+    snapshot.contextSwitches = contextSwitches.load();
+    return snapshot;
+}
 
-    std::cout << "----------------------------------------------------\n";
+void Scheduler::writeUtilization(std::ostream& out, const StatusSnapshot& snapshot) const {
+    int cores = static_cast<int>(snapshot.busyTicks.size());
+    int used = static_cast<int>(snapshot.running.size());
+
+    out << "CPU utilization: " << (cores > 0 ? used * 100 / cores : 0) << "%\n";
+    out << "Cores used: " << used << "\n";
+    out << "Cores available: " << (cores - used) << "\n";
+    for (int i = 0; i < cores; i++) {
+        uint64_t busy = snapshot.busyTicks[i];
+        uint64_t total = busy + snapshot.idleTicks[i];
+        out << "  Core " << i << ": busy " << busy << " ticks, idle " << snapshot.idleTicks[i] << " ticks ("
+            << (total > 0 ? busy * 100 / total : 0) << "% busy)\n";
+    }
 }
 
-void FCFSScheduler::saveStatusToFile(const std::string& path) {
-    std::lock_guard<std::mutex> lock(processMutex);
+void Scheduler::writeProcessLists(std::ostream& out, const StatusSnapshot& snapshot) const {
+    out << "Running processes:\n";
+    if (snapshot.running.empty()) {
+        out << "None\n";
+    }
+    for (const auto& r : snapshot.running) {
+        out << std::left << std::setw(12) << r.name
+            << " (" << r.timestamp << ")"
+            << "   Core: " << r.core
+            << "   " << r.currentLine << " / " << r.totalLines << "\n";
+    }
 
-    std::ofstream file(path);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open log file: " << path << std::endl;
-        return;
+    out << "\nFinished processes:\n";
+    if (snapshot.finished.size() == 0) {
+        out << "None\n";
+    }
+    for (uint64_t i = snapshot.finished.first; i < snapshot.finished.end; i++) {
+        const ProcessSummary& s = snapshot.finished.at(i);
+        out << std::left << std::setw(12) << s.name
+            << " (" << formatTimestamp(s.createdAt) << ")"
+            << "   Finished"
+            << "   " << s.totalLines << " / " << s.totalLines << "\n";
     }
+}
 
-    file << "CPU utilization: 100%\n";
-    file << "Cores used: " << coreCount << "\n";
-    file << "Cores available: 0\n";
-    file << "========================================\n";
+void Scheduler::getCoreTicks(int coreId, uint64_t& busy, uint64_t& idle) const {
+    busy = coreStats[coreId].busyTicks.load();
+    idle = coreStats[coreId].idleTicks.load();
+    uint64_t parkedSince = coreStats[coreId].parkedSince.load();
+    uint64_t now = simClock.now();
+    if (parkedSince != NOT_PARKED && now > parkedSince) idle += now - parkedSince;
+}
 
-    file << "Running processes:\n";
-    bool anyRunning = false;
+void Scheduler::getCpuTicks(uint64_t& active, uint64_t& idle) const {
+    active = idle = 0;
     for (int i = 0; i < coreCount; i++) {
-        Process* p = runningProcesses[i];
-        if (p) {
-            anyRunning = true;
-            file << std::left << std::setw(12) << p->name
-                 << " (" << p->timestamp << ")"
-                 << "   Core: " << i
-                 << "   " << p->currentLine << " / " << p->totalLines << "\n";
-        }
-    }
-    if (!anyRunning) {
-        file << "None\n";
+        uint64_t coreBusy, coreIdle;
+        getCoreTicks(i, coreBusy, coreIdle);
+        active += coreBusy;
+        idle += coreIdle;
     }
+}
 
-    file << "\nFinished processes:\n";
-    if (finishedProcesses.empty()) {
-        file << "None\n";
-    } else {
-        for (auto* p : finishedProcesses) {
-            file << std::left << std::setw(12) << p->name
-                 << " (" << p->timestamp << ")"
-                 << "   Finished"
-                 << "   " << p->totalLines << " / " << p->totalLines << "\n";
-        }
+void Scheduler::writeCounters(std::ostream& out) const {
+    uint64_t active, idle;
+    getCpuTicks(active, idle);
+    for (int i = 0; i < coreCount; i++) {
+        uint64_t coreBusy, coreIdle;
+        getCoreTicks(i, coreBusy, coreIdle);
+        out << "cpu." << i << ".active_ticks " << coreBusy << "\n";
+        out << "cpu." << i << ".idle_ticks " << coreIdle << "\n";
     }
+    out << "cpu.active_ticks " << active << "\n";
+    out << "cpu.idle_ticks " << idle << "\n";
+    out << "cpu.context_switches " << contextSwitches.load() << "\n";
+}
+
+// Reports are formatted from a snapshot into one buffer, so no core waits on the terminal or the disk
+void Scheduler::printStatus() {
+    StatusSnapshot snapshot = takeSnapshot();
+
+    std::ostringstream out;
+    out << "\n----------------------------------------------------\n";
+    writeUtilization(out, snapshot);
+    out << "Scheduler: " << policy->name() << "   Context switches: " << snapshot.contextSwitches << "\n";
+    writeProcessLists(out, snapshot);
+    out << "----------------------------------------------------\n";
 
-    file << "========================================\n";
+    std::lock_guard<std::mutex> consoleLock(consoleMutex);
+    std::cout << out.str();
+}
+
+void Scheduler::saveStatusToFile(const std::string& path) {
+    StatusSnapshot snapshot = takeSnapshot();
+
+    std::ostringstream out;
+    writeUtilization(out, snapshot);
+    out << "Scheduler: " << policy->name() << "\n";
+    out << "Context switches: " << snapshot.contextSwitches << "\n";
+    out << "========================================\n";
+    writeProcessLists(out, snapshot);
+    out << "========================================\n";
+
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open log file: " << path << std::endl;
+        return;
+    }
+    file << out.str();
     file.close();
 
     std::lock_guard<std::mutex> consoleLock(consoleMutex);
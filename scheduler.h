@@ -2,36 +2,138 @@
 #define SCHEDULER_H
 
 #include "process.h"
-#include <queue>
+#include "process_registry.h"
+#include "finished_list.h"
+#include "config.h"
+#include "timer_wheel.h"
+#include <cstdint>
+#include <deque>
+#include <memory>
 #include <vector>
 #include <thread>
 #include <atomic>
 #include <mutex>
+#include <condition_variable>
+#include <ostream>
+#include <string>
 
-class FCFSScheduler {
+// Decides when a running process has to give up its core
+class SchedulingPolicy {
+public:
+    virtual ~SchedulingPolicy() = default;
+    virtual const char* name() const = 0;
+    virtual bool shouldPreempt(uint32_t cyclesOnCore) const = 0;  // Checked after every cycle
+};
+
+// First come, first served: a process keeps its core until it finishes
+class FCFSPolicy : public SchedulingPolicy {
+public:
+    const char* name() const override { return "fcfs"; }
+    bool shouldPreempt(uint32_t) const override { return false; }
+};
+
+// Round robin: a process is requeued after running for one quantum
+class RRPolicy : public SchedulingPolicy {
+private:
+    uint32_t quantum;
+
+public:
+    explicit RRPolicy(uint32_t quantumCycles) : quantum(quantumCycles > 0 ? quantumCycles : 1) {}
+    const char* name() const override { return "rr"; }
+    bool shouldPreempt(uint32_t cyclesOnCore) const override { return cyclesOnCore >= quantum; }
+};
+
+std::unique_ptr<SchedulingPolicy> makeSchedulingPolicy(const SystemConfig& config);
+
+class Scheduler {
 private:
-    std::queue<Process*> readyQueue;
-    std::vector<Process*> runningProcesses;
-    std::vector<Process*> finishedProcesses;
+    // Per-core ready queue: the owning core pops from the front, idle cores steal from the back
+    struct RunQueue {
+        std::mutex lock;
+        std::deque<Process*> processes;
+        std::atomic<int> size{0};   // Lets cores skip empty queues without locking them
+    };
+
+    static constexpr uint64_t NOT_PARKED = UINT64_MAX;
+
+    // Ticks each core spent running a process vs parked with nothing to run
+    struct CoreStats {
+        std::atomic<uint64_t> busyTicks{0};
+        std::atomic<uint64_t> idleTicks{0};
+        std::atomic<uint64_t> parkedSince{NOT_PARKED};
+    };
+
+    std::vector<std::unique_ptr<RunQueue>> runQueues;
+    std::vector<CoreStats> coreStats;
+    std::atomic<int> queuedCount{0};       // Processes waiting across all run queues
+    std::mutex idleMutex;
+    std::condition_variable workAvailable; // Idle cores park here until enqueue() wakes them
+    std::atomic<int> parkedCores{0};       // Cores waiting on workAvailable; enqueue() skips idleMutex at zero
+    std::vector<std::atomic<Process*>> runningProcesses;
+    FinishedList finishedProcesses;         // Summaries only; the processes themselves are freed
+    std::atomic<uint64_t> finishesBegun{0};   // Bracket a process leaving its core for finishedProcesses,
+    std::atomic<uint64_t> finishesEnded{0};   // so a snapshot can tell when it would list it twice or not at all
+    std::mutex retiredMutex;
+    std::vector<Process*> retired;          // Finished and shrunk, deleted by reclaimRetired()
     std::vector<std::thread> workerThreads;
+    std::atomic<unsigned> nextQueue{0};    // Round-robin target for addProcess
+    std::atomic<uint64_t> contextSwitches{0};
+    std::unique_ptr<SchedulingPolicy> policy;
+    TimerWheel sleepers;                    // Sleeping processes, off-core until their wake tick
+    ProcessRegistry registry;               // Every process added and not yet deleted, by name and pid
+    bool clockListenerRegistered = false;
     int coreCount;
 
+    Process* popLocal(int coreId);          // Take from this core's own queue
+    Process* steal(int coreId);             // Take from another core's queue
+    void enqueue(int queueIndex, Process* p); // Append to a queue and wake an idle core
+    void wakeSleepers(uint64_t tick);       // Clock listener: requeue processes whose sleep ended
+    void retire(Process* p, int coreId);    // Replace a finished process with its summary record
+
+    // What screen -ls and report-util print, captured without stopping any core
+    struct StatusSnapshot {
+        struct Running {
+            std::string name;
+            std::string timestamp;
+            int core;
+            int currentLine;
+            int totalLines;
+        };
+        std::vector<Running> running;
+        FinishedList::View finished;
+        std::vector<uint64_t> busyTicks;    // Per core
+        std::vector<uint64_t> idleTicks;
+        uint64_t contextSwitches = 0;
+    };
+
+    StatusSnapshot takeSnapshot() const;
+    void writeUtilization(std::ostream& out, const StatusSnapshot& snapshot) const;
+    void writeProcessLists(std::ostream& out, const StatusSnapshot& snapshot) const;
+
 public:
-    FCFSScheduler(int cores = 4);
+    Scheduler(int cores = 4);
+    void setCoreCount(int cores);           // Only valid while the scheduler is stopped
+    void setPolicy(std::unique_ptr<SchedulingPolicy> newPolicy);  // Only valid while the scheduler is stopped
+    void setFinishedRetention(size_t records);  // Finished-process summaries kept, 0 for all; only while stopped
+    uint64_t getContextSwitches() const { return contextSwitches.load(); }
+    void getCoreTicks(int coreId, uint64_t& busy, uint64_t& idle) const;  // Includes a park still in progress
+    void getCpuTicks(uint64_t& active, uint64_t& idle) const;             // Summed over all cores
+    void writeCounters(std::ostream& out) const;  // "name value" lines for vmstat --raw
     void addProcess(Process* p);
-    Process* findProcess(const std::string& name);
+    Process* findProcess(const std::string& name);   // O(1), whatever the process's state
+    Process* findProcessByPid(int pid);
+    bool findFinished(const std::string& name, ProcessSummary& summary) const;  // Retained summary of a finished process
+    void reclaimRetired();                  // Console thread only, at a point where it holds no Process*
     void start();
     void stop();
     void workerThread(int coreId);
     void printStatus();
     void saveStatusToFile(const std::string& path);
-    const std::vector<Process*>& getRunningProcesses() const;
-    const std::vector<Process*>& getFinishedProcesses() const;
+    const std::vector<std::atomic<Process*>>& getRunningProcesses() const;
 };
 
 extern std::mutex consoleMutex;
-extern std::mutex processMutex;
 extern std::atomic<bool> schedulerRunning;
-extern FCFSScheduler scheduler;
+extern Scheduler scheduler;
 
 #endif
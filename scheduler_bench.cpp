@@ -0,0 +1,87 @@
+// Scheduler benchmarks, repeated for 1, 2, 4, ... emulated cores in fast-forward.
+//   dispatch: one-instruction processes spread over every core's run queue; measures
+//             how fast the cores pop or steal, run and retire them.
+//   ips:      independent arithmetic processes; measures aggregate instructions per
+//             second, including formatting and queueing each instruction's log line.
+//
+// Usage: scheduler_bench [dispatch|ips] [maxCores] [processesPerCore]
+#include "scheduler.h"
+#include "config.h"
+#include "memory_manager.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Runs every queued process to completion; returns the elapsed seconds
+static double runUntilDone(const std::vector<std::string>& names) {
+    auto started = std::chrono::steady_clock::now();
+    scheduler.start();
+
+    // Processes leave the registry once retired, so the first one still found is the oldest running
+    size_t pending = 0;
+    while (pending < names.size()) {
+        while (pending < names.size() && !scheduler.findProcess(names[pending])) pending++;
+        scheduler.reclaimRetired();
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    scheduler.stop();
+    return seconds;
+}
+
+static double runDispatch(int cores, int perCore) {
+    std::vector<std::string> names;
+    for (int i = 0; i < cores * perCore; i++) {
+        names.push_back("d" + std::to_string(i));
+        scheduler.addProcess(new Process(names.back(), 1, {"NOP"}));  // Runs one cycle, logs nothing
+    }
+    return static_cast<double>(names.size()) / runUntilDone(names);
+}
+
+static double runInstructions(int cores, int perCore) {
+    const int lines = 1000;
+    std::vector<std::string> program = {"DECLARE(x, 0)"};
+    while (static_cast<int>(program.size()) < lines) program.push_back("ADD(x, x, 1)");
+
+    // Names repeat across runs, so the log files are reused rather than multiplied
+    std::vector<std::string> names;
+    for (int i = 0; i < cores * perCore; i++) {
+        names.push_back("i" + std::to_string(i));
+        scheduler.addProcess(new Process(names.back(), lines, program));
+    }
+    return static_cast<double>(names.size()) * lines / runUntilDone(names);
+}
+
+int main(int argc, char* argv[]) {
+    std::string mode = argc > 1 ? argv[1] : "dispatch";
+    int maxCores = argc > 2 ? std::atoi(argv[2]) : 128;
+    int perCore = argc > 3 ? std::atoi(argv[3]) : (mode == "ips" ? 2 : 200);
+    if ((mode != "dispatch" && mode != "ips") || maxCores < 1 || perCore < 1) {
+        std::cout << "Usage: scheduler_bench [dispatch|ips] [maxCores] [processesPerCore]\n";
+        return 2;
+    }
+
+    systemConfig.tickMillis = 0;
+    systemConfig.delayPerExec = 0;
+    systemConfig.logFlush = "exit";
+    scheduler.setPolicy(std::make_unique<FCFSPolicy>());
+    scheduler.setFinishedRetention(1024);
+
+    std::cout << "Host threads: " << std::thread::hardware_concurrency() << "\n";
+    std::cout << std::setw(6) << "cores" << std::setw(20) << (mode == "ips" ? "instructions/s" : "dispatches/s") << std::setw(12) << "speedup" << "\n";
+    double baseline = 0;
+    for (int cores = 1; cores <= maxCores; cores *= 2) {
+        scheduler.setCoreCount(cores);
+        memManager.setCoreCount(cores);
+        double rate = mode == "ips" ? runInstructions(cores, perCore) : runDispatch(cores, perCore);
+        if (cores == 1) baseline = rate;
+        std::cout << std::setw(6) << cores << std::setw(20) << std::fixed << std::setprecision(0) << rate
+                  << std::setw(11) << std::setprecision(2) << rate / baseline << "x\n";
+    }
+    return 0;
+}
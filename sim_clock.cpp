@@ -0,0 +1,111 @@
+#include "sim_clock.h"
+#include <chrono>
+
+SimClock simClock;
+
+void SimClock::setTickMillis(uint32_t millis) {
+    std::lock_guard<std::mutex> lock(mutex);
+    tickMillis = millis;
+}
+
+void SimClock::addTickListener(TickListener listener) {
+    std::lock_guard<std::mutex> lock(mutex);
+    listeners.push_back(std::move(listener));
+    listenersChanged = true;
+}
+
+void SimClock::start() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (running) return;
+        running = true;
+        arrived = 0;
+    }
+    clockThread = std::thread(&SimClock::run, this);
+}
+
+void SimClock::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+    }
+    coresArrived.notify_all();
+    tickAdvanced.notify_all();
+    if (clockThread.joinable()) clockThread.join();
+}
+
+uint64_t SimClock::join() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        participants++;
+    }
+    coresArrived.notify_one();
+    return tick.load();
+}
+
+void SimClock::leave() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        participants--;
+    }
+    coresArrived.notify_one();
+}
+
+void SimClock::retain() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        retained++;
+    }
+    coresArrived.notify_one();
+}
+
+void SimClock::release() {
+    std::lock_guard<std::mutex> lock(mutex);
+    retained--;
+}
+
+uint64_t SimClock::awaitTick(uint64_t lastSeen) {
+    std::unique_lock<std::mutex> lock(mutex);
+    // The tick moved on since the caller joined (e.g. while listeners ran): it has not run
+    // that tick yet, so counting it now would let the barrier pass without one core's cycle
+    if (tick.load() > lastSeen) return tick.load();
+    if (++arrived >= participants) coresArrived.notify_one();
+    tickAdvanced.wait(lock, [&] { return !running || tick.load() > lastSeen; });
+    return tick.load();
+}
+
+void SimClock::run() {
+    using steadyClock = std::chrono::steady_clock;
+    auto deadline = steadyClock::now();
+    std::vector<TickListener> active;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (running) {
+        if (tickMillis > 0) {
+            deadline += std::chrono::milliseconds(tickMillis);
+            coresArrived.wait_until(lock, deadline, [&] { return !running; });
+        }
+        // With nobody to run, a fast-forward clock would just spin; wait for a core instead
+        coresArrived.wait(lock, [&] {
+            return !running || (arrived >= participants && (participants > 0 || retained > 0 || tickMillis > 0));
+        });
+        if (!running) break;
+
+        // Don't try to catch up on ticks lost to slow cores
+        if (steadyClock::now() > deadline) deadline = steadyClock::now();
+
+        if (listenersChanged) {
+            active = listeners;
+            listenersChanged = false;
+        }
+
+        uint64_t next = tick.load() + 1;
+        lock.unlock();
+        for (auto& listener : active) listener(next);
+        lock.lock();
+
+        tick = next;
+        arrived = 0;
+        tickAdvanced.notify_all();
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef SIM_CLOCK_H
+#define SIM_CLOCK_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Header file for sim_clock.cpp
+// Emulated CPU clock, separate from wall time. Every core that has joined the
+// clock runs one cycle per tick; the next tick starts once all of them have
+// finished the current one and (unless fast-forwarding) the tick duration has
+// elapsed.
+class SimClock {
+public:
+    using TickListener = std::function<void(uint64_t tick)>;
+
+    void setTickMillis(uint32_t millis);       // 0 = fast-forward, tick as soon as all cores are done
+    uint32_t getTickMillis() const { return tickMillis; }
+    bool isFastForward() const { return tickMillis == 0; }
+
+    void addTickListener(TickListener listener); // Runs on the clock thread before each tick is published
+
+    void start();
+    void stop();
+
+    uint64_t join();                            // Register a core from the tick after the one returned
+    void leave();                               // Unregister a core
+    uint64_t awaitTick(uint64_t lastSeen);      // Finish this core's cycle and wait for the next tick
+    void retain();                              // Keep ticking even with no cores joined (e.g. a pending timer)
+    void release();
+    uint64_t now() const { return tick.load(); }
+
+private:
+    std::mutex mutex;
+    std::condition_variable tickAdvanced;       // Clock -> cores
+    std::condition_variable coresArrived;       // Cores -> clock
+    std::atomic<uint64_t> tick{0};
+    int participants = 0;
+    int arrived = 0;
+    int retained = 0;
+    bool running = false;
+    uint32_t tickMillis = 150;
+
+    std::vector<TickListener> listeners;
+    bool listenersChanged = false;          // Clock thread re-copies listeners when set
+    std::thread clockThread;
+
+    void run();
+};
+
+extern SimClock simClock;
+
+#endif
@@ -0,0 +1,69 @@
+#include "timer_wheel.h"
+
+void TimerWheel::reset(uint64_t tick) {
+    std::lock_guard<std::mutex> lock(mutex);
+    current = tick;
+}
+
+bool TimerWheel::schedule(Process* p, uint64_t wakeTick) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (wakeTick <= current) return false;
+
+    insert({p, wakeTick});
+    count++;
+    return true;
+}
+
+size_t TimerWheel::pending() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return count;
+}
+
+void TimerWheel::insert(const Timer& timer) {
+    uint64_t delta = timer.wakeTick > current ? timer.wakeTick - current : 0;
+
+    for (int level = 0; level < LEVELS; ++level) {
+        if (level == LEVELS - 1 || (delta >> (SLOT_BITS * (level + 1))) == 0) {
+            // Anything past the top level's range waits in its furthest slot and is re-filed on cascade
+            uint64_t maxDelta = (uint64_t(1) << (SLOT_BITS * LEVELS)) - 1;
+            uint64_t when = delta > maxDelta ? current + maxDelta : timer.wakeTick;
+            size_t slot = (when >> (SLOT_BITS * level)) & (SLOTS - 1);
+            slots[level][slot].push_back(timer);
+            return;
+        }
+    }
+}
+
+// Re-file the timers of the higher-level slot that the current tick just reached
+void TimerWheel::cascade(int level) {
+    size_t slot = (current >> (SLOT_BITS * level)) & (SLOTS - 1);
+    std::vector<Timer> timers;
+    timers.swap(slots[level][slot]);
+    for (const auto& timer : timers) {
+        insert(timer);
+    }
+}
+
+void TimerWheel::advance(uint64_t tick, std::vector<Process*>& expired) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    while (current < tick) {
+        current++;
+
+        for (int level = 1; level < LEVELS; ++level) {
+            if ((current & ((uint64_t(1) << (SLOT_BITS * level)) - 1)) != 0) break;
+            cascade(level);
+        }
+
+        auto& due = slots[0][current & (SLOTS - 1)];
+        for (const auto& timer : due) {
+            if (timer.wakeTick <= current) {
+                expired.push_back(timer.process);
+                count--;
+            } else {
+                insert(timer);  // Parked past the top level's range
+            }
+        }
+        due.clear();
+    }
+}
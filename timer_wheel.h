@@ -0,0 +1,40 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+struct Process;
+
+// Header file for timer_wheel.cpp
+// Hierarchical timer wheel holding sleeping processes until their wake tick.
+// Level 0 has one slot per tick; each higher level covers SLOTS times the
+// range of the level below and is cascaded down as the lower level wraps.
+class TimerWheel {
+public:
+    static const int SLOT_BITS = 8;
+    static const int SLOTS = 1 << SLOT_BITS;
+    static const int LEVELS = 3;                    // Covers 2^24 ticks ahead
+
+    void reset(uint64_t tick);                      // Start counting from this tick (wheel must be empty)
+    bool schedule(Process* p, uint64_t wakeTick);   // false if wakeTick has already passed
+    void advance(uint64_t tick, std::vector<Process*>& expired);  // Move to tick, collecting due processes
+    size_t pending() const;
+
+private:
+    struct Timer {
+        Process* process;
+        uint64_t wakeTick;
+    };
+
+    mutable std::mutex mutex;
+    std::vector<Timer> slots[LEVELS][SLOTS];
+    uint64_t current = 0;
+    size_t count = 0;
+
+    void insert(const Timer& timer);
+    void cascade(int level);
+};
+
+#endif
@@ -0,0 +1,27 @@
+#include "tlb.h"
+
+static const uint64_t TAG_MASK = ~0xFFFFULL;
+
+int SoftwareTLB::lookup(int pid, int page) {
+    // Sequentially consistent, so a shootdown either clears this entry first or sees inAccess set
+    uint64_t entry = entries[slotOf(pid, page)].load();
+    if ((entry & TAG_MASK) == tagOf(pid, page)) {
+        hits.fetch_add(1, std::memory_order_relaxed);
+        return static_cast<int>(entry & 0xFFFF);
+    }
+    misses.fetch_add(1, std::memory_order_relaxed);
+    return -1;
+}
+
+void SoftwareTLB::insert(int pid, int page, int frame) {
+    entries[slotOf(pid, page)].store(tagOf(pid, page) | static_cast<uint64_t>(frame & 0xFFFF), std::memory_order_release);
+}
+
+void SoftwareTLB::invalidate(int pid, int page) {
+    // Only clear the slot if it still holds this translation
+    auto& slot = entries[slotOf(pid, page)];
+    uint64_t entry = slot.load();
+    while ((entry & TAG_MASK) == tagOf(pid, page)) {
+        if (slot.compare_exchange_weak(entry, 0)) break;
+    }
+}
@@ -0,0 +1,47 @@
+#ifndef TLB_H
+#define TLB_H
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+// Header file for tlb.cpp
+// Direct-mapped software TLB owned by one core. An entry caches the frame of
+// a (pid, page) pair in one packed word, so a lookup is a single atomic load.
+// Other cores only ever invalidate entries (shootdown), never fill them, and
+// then wait for any access that may have used the old entry to finish.
+class SoftwareTLB {
+public:
+    static const int ENTRIES = 64;  // Power of two
+
+    // Bracket a lookup and the memory access that uses its frame
+    void beginAccess() { inAccess.store(true); }
+    void endAccess() { inAccess.store(false, std::memory_order_release); }
+    void waitUntilIdle() const {
+        while (inAccess.load()) std::this_thread::yield();
+    }
+
+    int lookup(int pid, int page);                // Frame, or -1 on a miss
+    void insert(int pid, int page, int frame);
+    void invalidate(int pid, int page);           // Shootdown of one translation
+
+    uint64_t getHits() const { return hits.load(std::memory_order_relaxed); }
+    uint64_t getMisses() const { return misses.load(std::memory_order_relaxed); }
+
+private:
+    // Packed entry: valid (bit 63) | pid (bits 32-62) | page (bits 16-31) | frame (bits 0-15)
+    static constexpr uint64_t VALID = 1ULL << 63;
+    static uint64_t tagOf(int pid, int page) {
+        return VALID | (static_cast<uint64_t>(pid & 0x7FFFFFFF) << 32) | (static_cast<uint64_t>(page & 0xFFFF) << 16);
+    }
+    static int slotOf(int pid, int page) {
+        return static_cast<int>((static_cast<uint32_t>(pid) * 0x9E3779B1u ^ static_cast<uint32_t>(page)) & (ENTRIES - 1));
+    }
+
+    std::atomic<uint64_t> entries[ENTRIES] = {};
+    std::atomic<bool> inAccess{false};
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+};
+
+#endif
@@ -1,31 +1,30 @@
 #include "variable_manager.h"
-#include <iostream>
-#include <sstream>
+#include <algorithm>
 
-VariableManager varManager;
+VariableManager::VariableManager(std::pmr::memory_resource* resource) : slotOf(resource) {}
 
-int VariableManager::getValue(const std::string& token) {
-    std::istringstream iss(token);
-    int value;
-    if (iss >> value) return value; // literal number
-    return variables[token]; // defaults to 0 if not found
+void VariableManager::reset(size_t symbolCount) {
+    slotOf.assign(symbolCount, UNBOUND);
+    std::fill(values, values + MAX_VARIABLES, 0);
+    slotsUsed = 0;
 }
 
-void VariableManager::declare(const std::string& varName, uint16_t value) {
-    variables[varName] = value;
+uint16_t VariableManager::get(int symbol) const {
+    if (symbol < 0 || symbol >= static_cast<int>(slotOf.size())) return 0;
+    uint8_t slot = slotOf[symbol];
+    return slot == UNBOUND ? 0 : values[slot]; // defaults to 0 if never declared
 }
 
-bool VariableManager::has(const std::string& varName) {
-    return variables.find(varName) != variables.end();
-}
-
-void VariableManager::printAll() {
-    std::cout << "Declared Variables:\n";
-    for (const auto& [key, val] : variables) {
-        std::cout << key << " = " << val << "\n";
+void VariableManager::declare(int symbol, uint16_t value) {
+    if (symbol < 0 || symbol >= static_cast<int>(slotOf.size())) return;
+    uint8_t& slot = slotOf[symbol];
+    if (slot == UNBOUND) {
+        if (slotsUsed == MAX_VARIABLES) return; // symbol table full
+        slot = static_cast<uint8_t>(slotsUsed++);
     }
+    values[slot] = value;
 }
 
 uint16_t VariableManager::clamp16(int value) {
     return static_cast<uint16_t>(std::max(0, std::min(65535, value)));
-}
\ No newline at end of file
+}
@@ -1,23 +1,34 @@
 #ifndef VARIABLE_MANAGER_H
 #define VARIABLE_MANAGER_H
 
-#include <unordered_map>
-#include <string>
+#include <vector>
 #include <cstdint>
+#include <cstddef>
+#include <memory_resource>
 
+// Per-process symbol table: a fixed number of uint16 slots.
+// Variable names are resolved to symbol indices when the program is compiled;
+// a symbol is bound to a slot the first time it is written at run time, so the
+// slot limit counts variables the process actually declares.
 class VariableManager {
+public:
+    static const int MAX_VARIABLES = 64;    // 2 bytes per slot
+
+    explicit VariableManager(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
 private:
-    std::unordered_map<std::string, int> variables;
+    static constexpr uint8_t UNBOUND = 0xFF;
+
+    uint16_t values[MAX_VARIABLES] = {};
+    std::pmr::vector<uint8_t> slotOf;       // Symbol index -> slot, UNBOUND until first written
+    int slotsUsed = 0;
 
 public:
-    int getValue(const std::string& token);
-    void declare(const std::string& varName, uint16_t value);
-    void printAll();
-    bool has(const std::string& varName);
-    
+    void reset(size_t symbolCount);         // Unbind every symbol of a newly compiled program
+    uint16_t get(int symbol) const;         // 0 if never written
+    void declare(int symbol, uint16_t value); // Ignored for a new symbol once every slot is taken
+
     static uint16_t clamp16(int value);
 };
 
-extern VariableManager varManager;
-
-#endif
\ No newline at end of file
+#endif